@@ -0,0 +1,50 @@
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Summing a column with missing values: std::optional<double> (16 bytes) vs compact_optional<double> (8 bytes)
+
+namespace
+{
+	template <typename optional_t>
+	std::vector<optional_t> make_column(size_t count)
+	{
+		std::mt19937 gen(5);
+		std::vector<optional_t> out(count);
+		for (auto& v : out)
+		{
+			if (gen() % 8 != 0)
+			{
+				v = double(gen() & 0xFFFF) * 0.25;
+			}
+		}
+		return out;
+	}
+
+	template <typename optional_t>
+	void sum_column(benchmark::State& state)
+	{
+		const auto column = make_column<optional_t>(state.range(0));
+		for (auto _ : state)
+		{
+			double total = 0;
+			for (const auto& v : column)
+			{
+				total += v.value_or(0.0);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.counters["bytes"] = double(column.size() * sizeof(optional_t));
+		state.SetItemsProcessed(state.iterations() * column.size());
+	}
+}
+
+static void std_optional_sum(benchmark::State& state) { sum_column<std::optional<double>>(state); }
+static void compact_optional_sum(benchmark::State& state) { sum_column<cxpr::compact_optional<double>>(state); }
+
+BENCHMARK(std_optional_sum)->Arg(4096)->Arg(1 << 21);
+BENCHMARK(compact_optional_sum)->Arg(4096)->Arg(1 << 21);
@@ -0,0 +1,77 @@
+#include <random>
+#include <variant>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Scanning an event array: std::variant (index in its own word) vs compact_variant (index in a niche byte)
+
+namespace
+{
+	struct alignas(8) fill { uint32_t qty; uint16_t venue; uint8_t side; uint8_t reserved; static constexpr size_t niche_offset = 7; };
+	struct alignas(8) cancel { uint32_t order; uint8_t reason; uint8_t pad[2]; uint8_t reserved; static constexpr size_t niche_offset = 7; };
+	struct heartbeat { uint32_t seq; };
+
+	struct weight
+	{
+		int64_t operator()(const fill& e) const { return e.side == 'B' ? e.qty : -int64_t(e.qty); }
+		int64_t operator()(const cancel& e) const { return e.reason; }
+		int64_t operator()(const heartbeat&) const { return 0; }
+	};
+
+	template <typename array_t>
+	array_t make_events(size_t count)
+	{
+		std::mt19937 gen(11);
+		array_t out;
+		out.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint32_t v = gen() & 0xFFFF;
+			switch (gen() % 4)
+			{
+			case 0: out.emplace_back(cancel{ v, 1, {}, 0 }); break;
+			case 1: out.emplace_back(heartbeat{ v }); break;
+			default: out.emplace_back(fill{ v, 2, uint8_t(v & 1 ? 'B' : 'S'), 0 }); break;
+			}
+		}
+		return out;
+	}
+}
+
+static void std_variant_scan(benchmark::State& state)
+{
+	const auto events = make_events<std::vector<std::variant<fill, cancel, heartbeat>>>(state.range(0));
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& e : events)
+		{
+			total += std::visit(weight{}, e);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.counters["bytes"] = double(events.size() * sizeof(events[0]));
+	state.SetItemsProcessed(state.iterations() * events.size());
+}
+
+static void compact_variant_scan(benchmark::State& state)
+{
+	const auto events = make_events<std::vector<cxpr::compact_variant<fill, cancel, heartbeat>>>(state.range(0));
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& e : events)
+		{
+			total += e.visit(weight{});
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.counters["bytes"] = double(events.size() * sizeof(events[0]));
+	state.SetItemsProcessed(state.iterations() * events.size());
+}
+
+BENCHMARK(std_variant_scan)->Arg(4096)->Arg(1 << 21);
+BENCHMARK(compact_variant_scan)->Arg(4096)->Arg(1 << 21);
@@ -0,0 +1,149 @@
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Compile-time benchmark, nothing here runs. Time the two targets against each other:
+//	 time cmake --build build --target cxpr_typeset_compile_bench_baseline	// recursive unique, chained operator<<
+//	 time cmake --build build --target cxpr_typeset_compile_bench			// typeset algorithms
+// Both work on a 200-type message set with duplicates, like the ones event_bus/type_map are built from
+
+namespace
+{
+	template <int n>
+	struct message
+	{
+		char payload[n % 13 + 1];
+	};
+
+	template <int group, size_t ... i>
+	auto make_messages(std::index_sequence<i...>) -> cxpr::typeset<message<group * 1000 + int(i % 150)>...>;
+
+	template <int group>
+	using messages_t = decltype(make_messages<group>(std::make_index_sequence<200>{}));
+
+	template <typename ... sets_t>
+	struct bench_sets {};
+}
+
+#ifdef CXPR_COMPILE_BENCH_BASELINE
+
+// The implementations the typeset algorithms replaced: one instantiation per type, each checking every
+// type kept so far, and a typeset rebuilt by every operator<<
+namespace baseline
+{
+	using cxpr::typeset;
+
+	template <typename ... Ts>
+	struct unique_types;
+
+	template <typename curr_t, typename ... Ts>
+	struct unique_types<curr_t, Ts...>
+	{
+		template <typename ... out_ts>
+		static constexpr decltype(auto) iterate(typeset<out_ts...>* = nullptr)
+		{
+			constexpr bool type_exists = (... || std::is_same_v<std::decay<curr_t>, std::decay<out_ts>>);
+			if constexpr (type_exists == false)
+			{
+				return unique_types<Ts...>::iterate((typeset<out_ts..., curr_t>*)0);
+			}
+			else
+			{
+				return unique_types<Ts...>::iterate((typeset<out_ts...>*)0);
+			}
+		}
+
+		static constexpr decltype(auto) iterate()
+		{
+			return unique_types<Ts...>::iterate((typeset<curr_t>*)0);
+		}
+	};
+
+	template <>
+	struct unique_types<>
+	{
+		template <typename ... out_ts>
+		static constexpr decltype(auto) iterate(typeset<out_ts...>* = nullptr)
+		{
+			return typeset<out_ts...>();
+		}
+	};
+
+	template <template <typename ...> class wrapper_t, typename ... types_t>
+	constexpr decltype(auto) set_unique(const wrapper_t<types_t...>* = nullptr)
+	{
+		return unique_types<types_t...>::iterate();
+	}
+
+	template <typename set_t>
+	using unique_t = decltype(set_unique((set_t*)0));
+
+	struct starter_marker {};
+	using type_collector = typeset<starter_marker>;
+
+	template <template <typename ...> class right_t, typename ... collapsed_ts, typename ... right_ts>
+	decltype(auto) operator<<(const typeset<collapsed_ts...>, const right_t<right_ts...>*)
+	{
+		if constexpr (std::is_same_v<typeset<collapsed_ts...>, type_collector>)
+		{
+			return typeset<right_ts...>{};
+		}
+		else
+		{
+			return typeset<collapsed_ts..., right_ts...>{};
+		}
+	}
+
+	template <typename ... wrapped_types_t>
+	decltype(auto) collapse_types(wrapped_types_t* ... types)
+	{
+		return (type_collector{} << ... << types);
+	}
+
+	// Splits a set into 20 single-type sets so the collapse chains 20 operator<< per call
+	template <typename set_t, size_t ... i>
+	auto split(std::index_sequence<i...>) -> decltype(collapse_types((typeset<cxpr::typeset_element_t<i * 10, set_t>,
+		cxpr::typeset_element_t<i * 10 + 1, set_t>, cxpr::typeset_element_t<i * 10 + 2, set_t>, cxpr::typeset_element_t<i * 10 + 3, set_t>,
+		cxpr::typeset_element_t<i * 10 + 4, set_t>, cxpr::typeset_element_t<i * 10 + 5, set_t>, cxpr::typeset_element_t<i * 10 + 6, set_t>,
+		cxpr::typeset_element_t<i * 10 + 7, set_t>, cxpr::typeset_element_t<i * 10 + 8, set_t>, cxpr::typeset_element_t<i * 10 + 9, set_t>>*)0 ...));
+
+	template <typename set_t>
+	using collapse_t = decltype(split<set_t>(std::make_index_sequence<20>{}));
+}
+
+template <typename set_t>
+using bench_unique_t = baseline::unique_t<set_t>;
+
+template <typename set_t>
+using bench_collapse_t = baseline::collapse_t<set_t>;
+
+#else
+
+namespace current
+{
+	template <typename set_t, size_t ... i>
+	auto split(std::index_sequence<i...>) -> cxpr::typeset_concat_t<cxpr::typeset<cxpr::typeset_element_t<i * 10, set_t>,
+		cxpr::typeset_element_t<i * 10 + 1, set_t>, cxpr::typeset_element_t<i * 10 + 2, set_t>, cxpr::typeset_element_t<i * 10 + 3, set_t>,
+		cxpr::typeset_element_t<i * 10 + 4, set_t>, cxpr::typeset_element_t<i * 10 + 5, set_t>, cxpr::typeset_element_t<i * 10 + 6, set_t>,
+		cxpr::typeset_element_t<i * 10 + 7, set_t>, cxpr::typeset_element_t<i * 10 + 8, set_t>, cxpr::typeset_element_t<i * 10 + 9, set_t>>...>;
+
+	template <typename set_t>
+	using collapse_t = decltype(split<set_t>(std::make_index_sequence<20>{}));
+}
+
+template <typename set_t>
+using bench_unique_t = cxpr::typeset_unique_t<set_t>;
+
+template <typename set_t>
+using bench_collapse_t = current::collapse_t<set_t>;
+
+#endif
+
+// Ten independent message sets, so every instantiation is paid ten times
+template <int ... group>
+constexpr size_t run_bench(std::integer_sequence<int, group...>)
+{
+	static_assert((std::is_same_v<bench_collapse_t<messages_t<group>>, messages_t<group>> && ...), "collapse keeps every type");
+	return (cxpr::param_count_v<bench_unique_t<messages_t<group>>> + ...);
+}
+
+static_assert(run_bench(std::make_integer_sequence<int, 10>{}) == 10 * 150, "unique keeps one of each message");
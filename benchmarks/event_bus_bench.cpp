@@ -0,0 +1,138 @@
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Cost of publishing one event to four subscribers: event_bus (typed and type-erased) vs the usual
+// listener interface with a virtual handler per event type, and a typeid-keyed map of std::function lists
+
+namespace
+{
+	struct price_tick { int instrument; double price; };
+	struct trade { int instrument; double price; int qty; };
+
+	struct listener
+	{
+		virtual ~listener() = default;
+		virtual void on_event(const price_tick& e) = 0;
+		virtual void on_event(const trade& e) = 0;
+	};
+
+	struct accumulator : listener
+	{
+		double sum = 0;
+		void operator()(const price_tick& e) { sum += e.price; }
+		void operator()(const trade& e) { sum += e.price * e.qty; }
+		void on_event(const price_tick& e) override { (*this)(e); }
+		void on_event(const trade& e) override { (*this)(e); }
+	};
+
+	// second implementation, real systems have many and it keeps the compiler from devirtualizing the calls
+	struct counter : listener
+	{
+		int count = 0;
+		void operator()(const price_tick&) { count++; }
+		void operator()(const trade& e) { count += e.qty; }
+		void on_event(const price_tick& e) override { (*this)(e); }
+		void on_event(const trade& e) override { (*this)(e); }
+	};
+
+	using bus_t = cxpr::event_bus<cxpr::typeset<price_tick, trade>, 8>;
+}
+
+static void event_bus_publish(benchmark::State& state)
+{
+	accumulator subscribers[2];
+	counter counters[2];
+	bus_t bus;
+	for (size_t i = 0; i < 2; i++)
+	{
+		bus.subscribe<price_tick>(subscribers[i]);
+		bus.subscribe<price_tick>(counters[i]);
+	}
+
+	price_tick tick{ 1, 100.25 };
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(tick);
+		bus.publish(tick);
+	}
+	benchmark::DoNotOptimize(subscribers[0].sum);
+}
+
+static void event_bus_publish_erased(benchmark::State& state)
+{
+	accumulator subscribers[2];
+	counter counters[2];
+	bus_t bus;
+	for (size_t i = 0; i < 2; i++)
+	{
+		bus.subscribe<price_tick>(subscribers[i]);
+		bus.subscribe<price_tick>(counters[i]);
+	}
+
+	price_tick tick{ 1, 100.25 };
+	cxpr::hash_t key = cxpr::typehash_v<price_tick>;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(key);
+		bus.publish(key, &tick);
+	}
+	benchmark::DoNotOptimize(subscribers[0].sum);
+}
+
+static void virtual_publish(benchmark::State& state)
+{
+	accumulator subscribers[2];
+	counter counters[2];
+	std::vector<listener*> listeners;
+	for (size_t i = 0; i < 2; i++)
+	{
+		listeners.push_back(&subscribers[i]);
+		listeners.push_back(&counters[i]);
+	}
+
+	price_tick tick{ 1, 100.25 };
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(tick);
+		for (auto* l : listeners)
+		{
+			l->on_event(tick);
+		}
+	}
+	benchmark::DoNotOptimize(subscribers[0].sum);
+}
+
+static void function_map_publish(benchmark::State& state)
+{
+	accumulator subscribers[2];
+	counter counters[2];
+	std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> handlers;
+	auto& ticks = handlers[typeid(price_tick)];
+	for (size_t i = 0; i < 2; i++)
+	{
+		ticks.emplace_back([&sub = subscribers[i]](const void* e) { sub(*static_cast<const price_tick*>(e)); });
+		ticks.emplace_back([&sub = counters[i]](const void* e) { sub(*static_cast<const price_tick*>(e)); });
+	}
+
+	price_tick tick{ 1, 100.25 };
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(tick);
+		for (const auto& handler : handlers[typeid(price_tick)])
+		{
+			handler(&tick);
+		}
+	}
+	benchmark::DoNotOptimize(subscribers[0].sum);
+}
+
+BENCHMARK(event_bus_publish);
+BENCHMARK(event_bus_publish_erased);
+BENCHMARK(virtual_publish);
+BENCHMARK(function_map_publish);
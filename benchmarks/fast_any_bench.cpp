@@ -0,0 +1,46 @@
+#include <any>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Attribute bag round trip: store a value, check its type and read it back. fast_any vs std::any
+
+namespace
+{
+	struct attribute
+	{
+		std::string_view name;
+		uint64_t values[3];
+	};
+}
+
+static void fast_any_round_trip(benchmark::State& state)
+{
+	attribute attr{ "content-encoding", { 1, 2, 3 } };
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(attr);
+		cxpr::fast_any<48> holder = attr;
+		cxpr::fast_any<48> copy = holder;
+		benchmark::DoNotOptimize(copy.get<attribute>()->values[1]);
+		benchmark::DoNotOptimize(copy.get<int>());
+	}
+}
+
+static void std_any_round_trip(benchmark::State& state)
+{
+	attribute attr{ "content-encoding", { 1, 2, 3 } };
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(attr);
+		std::any holder = attr;
+		std::any copy = holder;
+		benchmark::DoNotOptimize(std::any_cast<attribute>(&copy)->values[1]);
+		benchmark::DoNotOptimize(std::any_cast<int>(&copy));
+	}
+}
+
+BENCHMARK(fast_any_round_trip);
+BENCHMARK(std_any_round_trip);
@@ -0,0 +1,79 @@
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Compares size-dependent fixed_string operations against std::string for capacities that
+// don't fit the remaining count in a single char
+
+template <size_t capacity>
+static std::string make_payload()
+{
+	return std::string(capacity - 1, 'x');
+}
+
+template <size_t capacity>
+static void fixed_string_equality(benchmark::State& state)
+{
+	const auto payload = make_payload<capacity>();
+	const auto ss1 = cxpr::fixed_string<capacity>(payload);
+	auto ss2 = cxpr::fixed_string<capacity>(payload);
+	ss2 = payload.substr(0, payload.size() - 1); // same size prefix would be too easy, differ in length
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ss1 == ss2);
+		benchmark::DoNotOptimize(ss1 == std::string_view(payload));
+	}
+}
+
+template <size_t capacity>
+static void std_string_equality(benchmark::State& state)
+{
+	const auto payload = make_payload<capacity>();
+	const std::string ss1 = payload;
+	const std::string ss2 = payload.substr(0, payload.size() - 1);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(ss1 == ss2);
+		benchmark::DoNotOptimize(ss1 == std::string_view(payload));
+	}
+}
+
+template <size_t capacity>
+static void fixed_string_append(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		cxpr::fixed_string<capacity> ss;
+		for (size_t i = 0; i < capacity - 1; i++)
+		{
+			ss.push_back('x');
+		}
+		benchmark::DoNotOptimize(ss.data());
+	}
+}
+
+template <size_t capacity>
+static void std_string_append(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		std::string ss;
+		for (size_t i = 0; i < capacity - 1; i++)
+		{
+			ss.push_back('x');
+		}
+		benchmark::DoNotOptimize(ss.data());
+	}
+}
+
+BENCHMARK_TEMPLATE(fixed_string_equality, 256);
+BENCHMARK_TEMPLATE(std_string_equality, 256);
+BENCHMARK_TEMPLATE(fixed_string_equality, 1024);
+BENCHMARK_TEMPLATE(std_string_equality, 1024);
+
+BENCHMARK_TEMPLATE(fixed_string_append, 256);
+BENCHMARK_TEMPLATE(std_string_append, 256);
+BENCHMARK_TEMPLATE(fixed_string_append, 1024);
+BENCHMARK_TEMPLATE(std_string_append, 1024);
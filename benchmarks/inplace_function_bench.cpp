@@ -0,0 +1,78 @@
+#include <functional>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Callback call overhead: inplace_function vs std::function vs a plain function pointer
+
+namespace
+{
+	int scale(int v) { return v * 3; }
+}
+
+static void function_pointer_call(benchmark::State& state)
+{
+	int (*fun)(int) = &scale;
+	benchmark::DoNotOptimize(fun);
+	int v = 1;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(v = fun(v));
+	}
+}
+
+static void inplace_function_call(benchmark::State& state)
+{
+	int offset = 3;
+	cxpr::inplace_function<int(int)> fun = [offset](int v) { return v * offset; };
+	benchmark::DoNotOptimize(fun);
+	int v = 1;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(v = fun(v));
+	}
+}
+
+static void std_function_call(benchmark::State& state)
+{
+	int offset = 3;
+	std::function<int(int)> fun = [offset](int v) { return v * offset; };
+	benchmark::DoNotOptimize(fun);
+	int v = 1;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(v = fun(v));
+	}
+}
+
+// Construct + move + call, a capture too large for std::function's small buffer
+static void inplace_function_move(benchmark::State& state)
+{
+	int64_t a = 1, b = 2, c = 3;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		cxpr::inplace_function<int64_t()> fun = [a, b, c] { return a + b + c; };
+		cxpr::inplace_function<int64_t()> moved = std::move(fun);
+		benchmark::DoNotOptimize(moved());
+	}
+}
+
+static void std_function_move(benchmark::State& state)
+{
+	int64_t a = 1, b = 2, c = 3;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a);
+		std::function<int64_t()> fun = [a, b, c] { return a + b + c; };
+		std::function<int64_t()> moved = std::move(fun);
+		benchmark::DoNotOptimize(moved());
+	}
+}
+
+BENCHMARK(function_pointer_call);
+BENCHMARK(inplace_function_call);
+BENCHMARK(std_function_call);
+BENCHMARK(inplace_function_move);
+BENCHMARK(std_function_move);
@@ -0,0 +1,43 @@
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Scanning a column of records: std::tuple<char, double, char, int> (24 bytes) vs packed_tuple (16 bytes)
+
+namespace
+{
+	template <typename record_t>
+	void scan_records(benchmark::State& state)
+	{
+		std::mt19937 gen(3);
+		std::vector<record_t> records;
+		records.reserve(state.range(0));
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			records.emplace_back(char(gen() & 1 ? 'B' : 'S'), double(gen() & 0xFFFF), char('N'), int(gen() & 0xFF));
+		}
+
+		for (auto _ : state)
+		{
+			double total = 0;
+			for (const auto& rec : records)
+			{
+				using std::get;
+				total += get<0>(rec) == 'B' ? get<1>(rec) * get<3>(rec) : -get<1>(rec);
+			}
+			benchmark::DoNotOptimize(total);
+		}
+		state.counters["bytes"] = double(records.size() * sizeof(record_t));
+		state.SetItemsProcessed(state.iterations() * records.size());
+	}
+}
+
+static void std_tuple_scan(benchmark::State& state) { scan_records<std::tuple<char, double, char, int>>(state); }
+static void packed_tuple_scan(benchmark::State& state) { scan_records<cxpr::packed_tuple<char, double, char, int>>(state); }
+
+BENCHMARK(std_tuple_scan)->Arg(4096)->Arg(1 << 21);
+BENCHMARK(packed_tuple_scan)->Arg(4096)->Arg(1 << 21);
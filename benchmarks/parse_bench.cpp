@@ -0,0 +1,91 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Field parsing out of fixed_string buffers: cxpr::parse vs the null-terminated, locale-aware std functions
+
+static std::vector<cxpr::fixed_string<32>> make_fields(bool floats)
+{
+	std::vector<cxpr::fixed_string<32>> fields;
+	uint64_t seed = 0x9E3779B97F4A7C15ull;
+	for (int i = 0; i < 1024; i++)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		cxpr::fixed_string<32> field;
+		if (floats)
+		{
+			field.append(static_cast<double>(seed >> 11) / 1e9);
+		}
+		else
+		{
+			field.append(static_cast<int64_t>(seed >> 20) - (1ll << 42));
+		}
+		fields.push_back(field);
+	}
+	return fields;
+}
+
+static void cxpr_parse_int(benchmark::State& state)
+{
+	const auto fields = make_fields(false);
+	for (auto _ : state)
+	{
+		for (const auto& field : fields)
+		{
+			int64_t value = 0;
+			benchmark::DoNotOptimize(cxpr::parse_to(field, value));
+			benchmark::DoNotOptimize(value);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * fields.size());
+}
+
+static void std_stoll(benchmark::State& state)
+{
+	const auto fields = make_fields(false);
+	for (auto _ : state)
+	{
+		for (const auto& field : fields)
+		{
+			benchmark::DoNotOptimize(std::stoll(std::string(field)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * fields.size());
+}
+
+static void cxpr_parse_double(benchmark::State& state)
+{
+	const auto fields = make_fields(true);
+	for (auto _ : state)
+	{
+		for (const auto& field : fields)
+		{
+			double value = 0;
+			benchmark::DoNotOptimize(cxpr::parse_to(field, value));
+			benchmark::DoNotOptimize(value);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * fields.size());
+}
+
+static void std_strtod(benchmark::State& state)
+{
+	const auto fields = make_fields(true);
+	for (auto _ : state)
+	{
+		for (const auto& field : fields)
+		{
+			benchmark::DoNotOptimize(std::strtod(field.c_str(), nullptr));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * fields.size());
+}
+
+BENCHMARK(cxpr_parse_int);
+BENCHMARK(std_stoll);
+BENCHMARK(cxpr_parse_double);
+BENCHMARK(std_strtod);
@@ -0,0 +1,77 @@
+#include <random>
+#include <variant>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Summing a shuffled mix of differently sized messages: std::vector<std::variant> visited per element vs
+// poly_collection's per-type loops
+
+namespace
+{
+	struct tick { int32_t price; };
+	struct quote { int32_t bid; int32_t ask; int64_t time; };
+	struct trade { int64_t id; int64_t time; int32_t price; int32_t size; char venue[16]; };
+
+	struct value_of
+	{
+		int64_t operator()(const tick& m) const { return m.price; }
+		int64_t operator()(const quote& m) const { return m.ask - m.bid; }
+		int64_t operator()(const trade& m) const { return int64_t(m.price) * m.size; }
+	};
+
+	using message_t = std::variant<tick, quote, trade>;
+	using collection_t = cxpr::poly_collection<cxpr::typeset<tick, quote, trade>>;
+
+	template <typename fun_t>
+	void generate(size_t count, fun_t&& add)
+	{
+		std::mt19937 gen(3);
+		for (size_t i = 0; i < count; i++)
+		{
+			const int32_t v = gen() & 0xFFF;
+			switch (gen() % 8)
+			{
+			case 0: add(trade{ int64_t(i), 0, v, 3, {} }); break;
+			case 1: case 2: case 3: add(quote{ v, v + 2, 0 }); break;
+			default: add(tick{ v }); break;
+			}
+		}
+	}
+}
+
+static void variant_vector_sum(benchmark::State& state)
+{
+	std::vector<message_t> messages;
+	generate(state.range(0), [&](auto m) { messages.emplace_back(m); });
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& m : messages)
+		{
+			total += std::visit(value_of{}, m);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.counters["bytes"] = double(messages.size() * sizeof(message_t));
+	state.SetItemsProcessed(state.iterations() * messages.size());
+}
+
+static void poly_collection_sum(benchmark::State& state)
+{
+	collection_t messages;
+	generate(state.range(0), [&](auto m) { messages.insert(m); });
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		messages.for_each([&](const auto& m) { total += value_of{}(m); });
+		benchmark::DoNotOptimize(total);
+	}
+	state.counters["bytes"] = double(messages.payload_bytes());
+	state.SetItemsProcessed(state.iterations() * messages.size());
+}
+
+BENCHMARK(variant_vector_sum)->Arg(4096)->Arg(1 << 18);
+BENCHMARK(poly_collection_sum)->Arg(4096)->Arg(1 << 18);
@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Parsing key=value records into a tuple: an if/else chain of name compares vs record_schema. 'order' has
+// 8 fields that always come in the same order, 'quote' has 24 that come shuffled
+
+namespace
+{
+	constexpr auto id = CXPR_LITERAL("id");
+	constexpr auto sym = CXPR_LITERAL("sym");
+	constexpr auto side = CXPR_LITERAL("side");
+	constexpr auto px = CXPR_LITERAL("px");
+	constexpr auto qty = CXPR_LITERAL("qty");
+	constexpr auto venue = CXPR_LITERAL("venue");
+	constexpr auto account = CXPR_LITERAL("account");
+	constexpr auto live = CXPR_LITERAL("live");
+
+	using order_schema = cxpr::record_schema<
+		cxpr::field<decltype(id), uint64_t>,
+		cxpr::field<decltype(sym), cxpr::fixed_string<16>>,
+		cxpr::field<decltype(side), std::string_view>,
+		cxpr::field<decltype(px), double>,
+		cxpr::field<decltype(qty), uint32_t>,
+		cxpr::field<decltype(venue), std::string_view>,
+		cxpr::field<decltype(account), cxpr::fixed_string<16>>,
+		cxpr::field<decltype(live), bool>>;
+	using order_t = order_schema::tuple_t;
+
+	std::vector<std::string> make_records(size_t count)
+	{
+		std::mt19937 gen(11);
+		std::vector<std::string> out;
+		for (size_t i = 0; i < count; i++)
+		{
+			out.push_back("id=" + std::to_string(gen()) + ";sym=AAPL;side=B;px=" + std::to_string(gen() & 0xFFFF) + ".25;qty="
+				+ std::to_string(gen() & 0xFFF) + ";venue=XNAS;account=ACC" + std::to_string(gen() & 0xFF) + ";live=true");
+		}
+		return out;
+	}
+
+	bool store_text(std::string_view in, cxpr::fixed_string<16>& out)
+	{
+		if (in.size() > out.capacity())
+		{
+			return false;
+		}
+		out.clear();
+		out.append(in);
+		return true;
+	}
+
+	// What record_schema replaces
+	bool parse_chain(std::string_view text, order_t& order)
+	{
+		for (auto pair : cxpr::make_splitter(text, ';', true))
+		{
+			const size_t split = pair.find('=');
+			if (split == std::string_view::npos)
+			{
+				return false;
+			}
+			const auto key = pair.substr(0, split);
+			const auto value = pair.substr(split + 1);
+			bool ok = true;
+			if (key == "id") { ok = cxpr::parse_to(value, std::get<0>(order)) == std::errc{}; }
+			else if (key == "sym") { ok = store_text(value, std::get<1>(order)); }
+			else if (key == "side") { std::get<2>(order) = value; }
+			else if (key == "px") { ok = cxpr::parse_to(value, std::get<3>(order)) == std::errc{}; }
+			else if (key == "qty") { ok = cxpr::parse_to(value, std::get<4>(order)) == std::errc{}; }
+			else if (key == "venue") { std::get<5>(order) = value; }
+			else if (key == "account") { ok = store_text(value, std::get<6>(order)); }
+			else if (key == "live") { std::get<7>(order) = (value == "true"); }
+			if (!ok)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	namespace wide
+	{
+		constexpr auto bid_px = CXPR_LITERAL("bid_px");
+		constexpr auto ask_px = CXPR_LITERAL("ask_px");
+		constexpr auto bid_qty = CXPR_LITERAL("bid_qty");
+		constexpr auto ask_qty = CXPR_LITERAL("ask_qty");
+		constexpr auto last_px = CXPR_LITERAL("last_px");
+		constexpr auto last_qty = CXPR_LITERAL("last_qty");
+		constexpr auto open = CXPR_LITERAL("open");
+		constexpr auto high = CXPR_LITERAL("high");
+		constexpr auto low = CXPR_LITERAL("low");
+		constexpr auto close = CXPR_LITERAL("close");
+		constexpr auto vwap = CXPR_LITERAL("vwap");
+		constexpr auto turnover = CXPR_LITERAL("turnover");
+		constexpr auto trades = CXPR_LITERAL("trades");
+		constexpr auto seq = CXPR_LITERAL("seq");
+		constexpr auto ts = CXPR_LITERAL("ts");
+		constexpr auto exch_ts = CXPR_LITERAL("exch_ts");
+		constexpr auto cond = CXPR_LITERAL("cond");
+		constexpr auto flags = CXPR_LITERAL("flags");
+		constexpr auto lot = CXPR_LITERAL("lot");
+		constexpr auto tick = CXPR_LITERAL("tick");
+		constexpr auto status = CXPR_LITERAL("status");
+		constexpr auto session = CXPR_LITERAL("session");
+		constexpr auto open_int = CXPR_LITERAL("open_int");
+		constexpr auto settle = CXPR_LITERAL("settle");
+
+		using quote_schema = cxpr::record_schema<
+			cxpr::field<decltype(bid_px), uint32_t>,
+			cxpr::field<decltype(ask_px), uint32_t>,
+			cxpr::field<decltype(bid_qty), uint32_t>,
+			cxpr::field<decltype(ask_qty), uint32_t>,
+			cxpr::field<decltype(last_px), uint32_t>,
+			cxpr::field<decltype(last_qty), uint32_t>,
+			cxpr::field<decltype(open), uint32_t>,
+			cxpr::field<decltype(high), uint32_t>,
+			cxpr::field<decltype(low), uint32_t>,
+			cxpr::field<decltype(close), uint32_t>,
+			cxpr::field<decltype(vwap), uint32_t>,
+			cxpr::field<decltype(turnover), uint32_t>,
+			cxpr::field<decltype(trades), uint32_t>,
+			cxpr::field<decltype(seq), uint32_t>,
+			cxpr::field<decltype(ts), uint32_t>,
+			cxpr::field<decltype(exch_ts), uint32_t>,
+			cxpr::field<decltype(cond), uint32_t>,
+			cxpr::field<decltype(flags), uint32_t>,
+			cxpr::field<decltype(lot), uint32_t>,
+			cxpr::field<decltype(tick), uint32_t>,
+			cxpr::field<decltype(status), uint32_t>,
+			cxpr::field<decltype(session), uint32_t>,
+			cxpr::field<decltype(open_int), uint32_t>,
+			cxpr::field<decltype(settle), uint32_t>>;
+	}
+
+	using quote_t = wide::quote_schema::tuple_t;
+
+	std::vector<std::string> make_quotes(size_t count)
+	{
+		constexpr std::string_view names[] = { "bid_px", "ask_px", "bid_qty", "ask_qty", "last_px", "last_qty", "open", "high", "low", "close", "vwap", "turnover", "trades", "seq", "ts", "exch_ts", "cond", "flags", "lot", "tick", "status", "session", "open_int", "settle" };
+		std::mt19937 gen(13);
+		std::vector<size_t> order(std::size(names));
+		std::vector<std::string> out;
+		for (size_t i = 0; i < count; i++)
+		{
+			for (size_t j = 0; j < order.size(); j++)
+			{
+				order[j] = j;
+			}
+			std::shuffle(order.begin(), order.end(), gen);
+			std::string quote;
+			for (size_t idx : order)
+			{
+				quote += std::string(names[idx]) + "=" + std::to_string(gen() & 0xFFFFF) + ";";
+			}
+			out.push_back(quote);
+		}
+		return out;
+	}
+
+	bool parse_quote_chain(std::string_view text, quote_t& quote)
+	{
+		for (auto pair : cxpr::make_splitter(text, ';', true))
+		{
+			const size_t split = pair.find('=');
+			if (split == std::string_view::npos)
+			{
+				return false;
+			}
+			const auto key = pair.substr(0, split);
+			uint32_t* slot = nullptr;
+			if (key == "bid_px") { slot = &std::get<0>(quote); }
+			else if (key == "ask_px") { slot = &std::get<1>(quote); }
+			else if (key == "bid_qty") { slot = &std::get<2>(quote); }
+			else if (key == "ask_qty") { slot = &std::get<3>(quote); }
+			else if (key == "last_px") { slot = &std::get<4>(quote); }
+			else if (key == "last_qty") { slot = &std::get<5>(quote); }
+			else if (key == "open") { slot = &std::get<6>(quote); }
+			else if (key == "high") { slot = &std::get<7>(quote); }
+			else if (key == "low") { slot = &std::get<8>(quote); }
+			else if (key == "close") { slot = &std::get<9>(quote); }
+			else if (key == "vwap") { slot = &std::get<10>(quote); }
+			else if (key == "turnover") { slot = &std::get<11>(quote); }
+			else if (key == "trades") { slot = &std::get<12>(quote); }
+			else if (key == "seq") { slot = &std::get<13>(quote); }
+			else if (key == "ts") { slot = &std::get<14>(quote); }
+			else if (key == "exch_ts") { slot = &std::get<15>(quote); }
+			else if (key == "cond") { slot = &std::get<16>(quote); }
+			else if (key == "flags") { slot = &std::get<17>(quote); }
+			else if (key == "lot") { slot = &std::get<18>(quote); }
+			else if (key == "tick") { slot = &std::get<19>(quote); }
+			else if (key == "status") { slot = &std::get<20>(quote); }
+			else if (key == "session") { slot = &std::get<21>(quote); }
+			else if (key == "open_int") { slot = &std::get<22>(quote); }
+			else if (key == "settle") { slot = &std::get<23>(quote); }
+			if (slot != nullptr && cxpr::parse_to(pair.substr(split + 1), *slot) != std::errc{})
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+static void record_if_chain(benchmark::State& state)
+{
+	const auto records = make_records(state.range(0));
+	order_t order{};
+	for (auto _ : state)
+	{
+		for (const auto& record : records)
+		{
+			benchmark::DoNotOptimize(parse_chain(record, order));
+		}
+		benchmark::DoNotOptimize(order);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void record_schema_kv(benchmark::State& state)
+{
+	const auto records = make_records(state.range(0));
+	order_t order{};
+	for (auto _ : state)
+	{
+		for (const auto& record : records)
+		{
+			benchmark::DoNotOptimize(order_schema::parse_kv(record, order));
+		}
+		benchmark::DoNotOptimize(order);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void record_wide_if_chain(benchmark::State& state)
+{
+	const auto records = make_quotes(state.range(0));
+	quote_t quote{};
+	for (auto _ : state)
+	{
+		for (const auto& record : records)
+		{
+			benchmark::DoNotOptimize(parse_quote_chain(record, quote));
+		}
+		benchmark::DoNotOptimize(quote);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void record_wide_schema_kv(benchmark::State& state)
+{
+	const auto records = make_quotes(state.range(0));
+	quote_t quote{};
+	for (auto _ : state)
+	{
+		for (const auto& record : records)
+		{
+			benchmark::DoNotOptimize(wide::quote_schema::parse_kv(record, quote));
+		}
+		benchmark::DoNotOptimize(quote);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(record_if_chain)->Arg(4096);
+BENCHMARK(record_schema_kv)->Arg(4096);
+BENCHMARK(record_wide_if_chain)->Arg(4096);
+BENCHMARK(record_wide_schema_kv)->Arg(4096);
@@ -0,0 +1,78 @@
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Reading one field out of a buffer of serialized records: deserialize every record vs serial_view
+
+namespace
+{
+	using fill_t = std::tuple<uint64_t, cxpr::fixed_string<16>, double, cxpr::fixed_vector<uint32_t, 8>>;
+	constexpr size_t record_size = cxpr::serialized_size_v<fill_t>;
+
+	std::vector<unsigned char> make_records(size_t count)
+	{
+		std::mt19937 gen(9);
+		std::vector<unsigned char> out(count * record_size);
+		for (size_t i = 0; i < count; i++)
+		{
+			fill_t fill{ gen(), cxpr::fixed_string<16>("XNAS"), double(gen() & 0xFFFF), cxpr::fixed_vector<uint32_t, 8>{} };
+			std::get<3>(fill).push_back(gen());
+			cxpr::serialize(fill, out.data() + i * record_size);
+		}
+		return out;
+	}
+}
+
+static void serialize_write(benchmark::State& state)
+{
+	fill_t fill{ 1, cxpr::fixed_string<16>("XNAS"), 2.5, cxpr::fixed_vector<uint32_t, 8>{} };
+	std::get<3>(fill).push_back(3);
+	std::vector<unsigned char> out(state.range(0) * record_size);
+	for (auto _ : state)
+	{
+		for (size_t i = 0; i < size_t(state.range(0)); i++)
+		{
+			cxpr::serialize(fill, out.data() + i * record_size);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void deserialize_read(benchmark::State& state)
+{
+	const auto records = make_records(state.range(0));
+	for (auto _ : state)
+	{
+		double total = 0;
+		for (size_t i = 0; i < size_t(state.range(0)); i++)
+		{
+			total += std::get<2>(cxpr::deserialize<fill_t>(records.data() + i * record_size, record_size));
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void serial_view_read(benchmark::State& state)
+{
+	const auto records = make_records(state.range(0));
+	for (auto _ : state)
+	{
+		double total = 0;
+		for (size_t i = 0; i < size_t(state.range(0)); i++)
+		{
+			total += cxpr::serial_view<fill_t>(records.data() + i * record_size, record_size).get<2>();
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(serialize_write)->Arg(4096);
+BENCHMARK(deserialize_read)->Arg(4096);
+BENCHMARK(serial_view_read)->Arg(4096);
@@ -0,0 +1,62 @@
+#include <typeindex>
+#include <unordered_map>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Per-type value lookup: type_map (static and runtime hash) vs std::unordered_map<std::type_index, ...>
+
+namespace
+{
+	template <int n> struct message {};
+	using message_types_t = cxpr::typeset<message<0>, message<1>, message<2>, message<3>, message<4>, message<5>,
+		message<6>, message<7>, message<8>, message<9>, message<10>, message<11>, message<12>, message<13>>;
+
+	template <typename ... types_t>
+	std::unordered_map<std::type_index, int> make_type_index_map(cxpr::typeset<types_t...>)
+	{
+		std::unordered_map<std::type_index, int> out;
+		int i = 0;
+		(out.emplace(std::type_index(typeid(types_t)), i++), ...);
+		return out;
+	}
+}
+
+static void type_map_static_get(benchmark::State& state)
+{
+	cxpr::type_map<message_types_t, int> values;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(values.get<message<3>>());
+		benchmark::DoNotOptimize(values.get<message<11>>());
+	}
+}
+
+static void type_map_hash_get(benchmark::State& state)
+{
+	cxpr::type_map<message_types_t, int> values;
+	cxpr::hash_t keys[] = { cxpr::typehash_v<message<3>>, cxpr::typehash_v<message<11>> };
+	benchmark::DoNotOptimize(keys);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(values.get(keys[0]));
+		benchmark::DoNotOptimize(values.get(keys[1]));
+	}
+}
+
+static void type_index_map_get(benchmark::State& state)
+{
+	auto values = make_type_index_map(message_types_t{});
+	std::type_index keys[] = { typeid(message<3>), typeid(message<11>) };
+	benchmark::DoNotOptimize(keys);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(values.find(keys[0]));
+		benchmark::DoNotOptimize(values.find(keys[1]));
+	}
+}
+
+BENCHMARK(type_map_static_get);
+BENCHMARK(type_map_hash_get);
+BENCHMARK(type_index_map_get);
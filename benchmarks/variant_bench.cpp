@@ -0,0 +1,258 @@
+#include <cmath>
+#include <random>
+#include <variant>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+// Visiting a shuffled array of variants: jump_visit vs std::visit vs a hand-written switch on index(),
+// and batch_visit grouping the same work by alternative
+
+namespace
+{
+	struct add { int64_t v; };
+	struct sub { int64_t v; };
+	struct mul { int64_t v; };
+	struct shl { int64_t v; };
+	using op_t = std::variant<add, sub, mul, shl>;
+
+	struct apply
+	{
+		int64_t operator()(const add& op) const { return op.v + 1; }
+		int64_t operator()(const sub& op) const { return op.v - 1; }
+		int64_t operator()(const mul& op) const { return op.v * 3; }
+		int64_t operator()(const shl& op) const { return op.v << 2; }
+	};
+
+	// Handlers with their own control flow: per item the loop exits mispredict, grouped they don't
+	template <int n> struct packet { int64_t v; };
+	using packet_t = std::variant<packet<0>, packet<1>, packet<2>, packet<3>, packet<4>, packet<5>, packet<6>, packet<7>>;
+
+	struct process
+	{
+		template <int n>
+		int64_t operator()(const packet<n>& p) const
+		{
+			int64_t r = p.v;
+			for (int i = 0; i < 2 + n * 3; i++)
+			{
+				r = r * 31 + i;
+			}
+			return r;
+		}
+	};
+
+	template <size_t ... idx>
+	packet_t make_packet(size_t kind, int64_t v, std::index_sequence<idx...>)
+	{
+		packet_t out;
+		((kind == idx ? (void)(out = packet<idx>{ v }) : void()), ...);
+		return out;
+	}
+
+	std::vector<packet_t> make_packets(size_t count)
+	{
+		std::mt19937 gen(7);
+		std::vector<packet_t> out;
+		out.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const size_t kind = gen() % 8;
+			out.push_back(make_packet(kind, gen() & 0xFF, std::make_index_sequence<8>{}));
+		}
+		return out;
+	}
+
+	struct combine
+	{
+		template <typename l_t, typename r_t>
+		int64_t operator()(const l_t& l, const r_t& r) const { return apply{}(l) ^ apply{}(r); }
+	};
+
+	std::vector<op_t> make_ops(size_t count)
+	{
+		std::mt19937 gen(42);
+		std::vector<op_t> out;
+		out.reserve(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const int64_t v = gen() & 0xFF;
+			switch (gen() % 4)
+			{
+			case 0: out.emplace_back(add{ v }); break;
+			case 1: out.emplace_back(sub{ v }); break;
+			case 2: out.emplace_back(mul{ v }); break;
+			default: out.emplace_back(shl{ v }); break;
+			}
+		}
+		return out;
+	}
+
+	const std::vector<op_t> ops = make_ops(4096);
+	const std::vector<packet_t> packets = make_packets(4096);
+}
+
+static void jump_visit_single(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& op : ops)
+		{
+			total += cxpr::jump_visit(apply{}, op);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+static void std_visit_single(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& op : ops)
+		{
+			total += std::visit(apply{}, op);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+static void switch_single(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& op : ops)
+		{
+			switch (op.index())
+			{
+			case 0: total += apply{}(*std::get_if<0>(&op)); break;
+			case 1: total += apply{}(*std::get_if<1>(&op)); break;
+			case 2: total += apply{}(*std::get_if<2>(&op)); break;
+			case 3: total += apply{}(*std::get_if<3>(&op)); break;
+			}
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+static void jump_visit_double(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (size_t i = 1; i < ops.size(); i++)
+		{
+			total += cxpr::jump_visit(combine{}, ops[i - 1], ops[i]);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+static void std_visit_double(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (size_t i = 1; i < ops.size(); i++)
+		{
+			total += std::visit(combine{}, ops[i - 1], ops[i]);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+// Same work grouped by alternative, the per-type loops have no dispatch left in them
+static void batch_visit_blocked(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		cxpr::batch_visit(ops, [&](const auto& op) { total += apply{}(op); });
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+static void batch_visit_whole_range(benchmark::State& state)
+{
+	std::vector<size_t> scratch;
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		cxpr::batch_visit<cxpr::batch_order::whole_range>(ops, [&](const auto& op) { total += apply{}(op); }, scratch);
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * ops.size());
+}
+
+static void jump_visit_process(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& p : packets)
+		{
+			total += cxpr::jump_visit(process{}, p);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+static void std_visit_process(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		for (const auto& p : packets)
+		{
+			total += std::visit(process{}, p);
+		}
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+static void batch_visit_blocked_process(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		cxpr::batch_visit(packets, [&](const auto& p) { total += process{}(p); });
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+static void batch_visit_whole_range_process(benchmark::State& state)
+{
+	std::vector<size_t> scratch;
+	for (auto _ : state)
+	{
+		int64_t total = 0;
+		cxpr::batch_visit<cxpr::batch_order::whole_range>(packets, [&](const auto& p) { total += process{}(p); }, scratch);
+		benchmark::DoNotOptimize(total);
+	}
+	state.SetItemsProcessed(state.iterations() * packets.size());
+}
+
+BENCHMARK(jump_visit_single);
+BENCHMARK(std_visit_single);
+BENCHMARK(switch_single);
+BENCHMARK(batch_visit_blocked);
+BENCHMARK(batch_visit_whole_range);
+BENCHMARK(jump_visit_process);
+BENCHMARK(std_visit_process);
+BENCHMARK(batch_visit_blocked_process);
+BENCHMARK(batch_visit_whole_range_process);
+BENCHMARK(jump_visit_double);
+BENCHMARK(std_visit_double);
@@ -0,0 +1,233 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Policies for compact_optional, each one names a value of T that stands for "empty"
+
+	// One specific value, storing it is the same as reset()
+	//	 cxpr::compact_optional<uint32_t, cxpr::sentinel_policy<uint32_t, UINT32_MAX>> qty;
+	template <typename T, T sentinel>
+	struct sentinel_policy
+	{
+		static constexpr void set_empty(T& value) noexcept { value = sentinel; }
+		static constexpr bool is_empty(const T& value) noexcept { return value == sentinel; }
+	};
+
+	// Any NaN is empty, for floating point columns where NaN was never a real value
+	template <typename T>
+	struct nan_policy
+	{
+		static_assert(std::numeric_limits<T>::has_quiet_NaN, "nan_policy needs a floating point type");
+
+		static constexpr void set_empty(T& value) noexcept { value = std::numeric_limits<T>::quiet_NaN(); }
+		static constexpr bool is_empty(const T& value) noexcept { return value != value; }
+	};
+
+	// A value T can never hold, taken from its niche_traits (see compact_variant.h): the niche byte is set to
+	// first_free. Needs a niche with invalid values (first_free > 0), a byte T merely doesn't use could be
+	// overwritten by assignment
+	template <typename T>
+	struct niche_policy
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "niche_policy needs a trivially copyable type");
+		static_assert(niche_traits<T>::offset < sizeof(T) && niche_traits<T>::first_free > 0 && niche_traits<T>::first_free < 256,
+			"niche_policy needs a niche byte with unused values");
+
+		static void set_empty(T& value) noexcept
+		{
+			reinterpret_cast<unsigned char*>(&value)[niche_traits<T>::offset] = static_cast<unsigned char>(niche_traits<T>::first_free);
+		}
+
+		static bool is_empty(const T& value) noexcept
+		{
+			return reinterpret_cast<const unsigned char*>(&value)[niche_traits<T>::offset] == niche_traits<T>::first_free;
+		}
+	};
+
+	namespace __detail
+	{
+		template <typename T, typename = void>
+		struct default_optional_policy
+		{
+			static_assert(sizeof(T) == 0, "no default compact_optional policy for this type, pass a sentinel_policy");
+		};
+
+		template <typename T>
+		struct default_optional_policy<T, std::enable_if_t<std::is_floating_point_v<T>>>
+		{
+			using type = nan_policy<T>;
+		};
+
+		template <typename T>
+		struct default_optional_policy<T, std::enable_if_t<(niche_traits<T>::first_free > 0)>>
+		{
+			using type = niche_policy<T>;
+		};
+	}
+
+	template <typename T, typename policy_t = typename __detail::default_optional_policy<T>::type>
+	class compact_optional;
+
+	template <typename T>
+	constexpr bool is_compact_optional_v = false;
+
+	template <typename T, typename policy_t>
+	constexpr bool is_compact_optional_v<compact_optional<T, policy_t>> = true;
+
+	namespace __detail
+	{
+		// Result of compact_optional::apply, add_optional_t is only looked at for non-compact results
+		template <typename R, bool compact = is_compact_optional_v<R>>
+		struct compact_apply_result
+		{
+			using type = add_optional_t<R>;
+		};
+
+		template <typename R>
+		struct compact_apply_result<R, true>
+		{
+			using type = R;
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Optional that encodes "empty" in a value of T picked by the policy, so it takes exactly sizeof(T)
+	// (std::optional<double> is 16 bytes, compact_optional<double> is 8). Floating point types default to
+	// nan_policy and types with a niche (niche_traits) to niche_policy, everything else needs a policy:
+	//	 cxpr::compact_optional<double> price;
+	//	 cxpr::compact_optional<uint32_t, cxpr::sentinel_policy<uint32_t, 0>> order_id;
+	// Has the same apply/map/and_then/or_else combinators as optional_ex
+	template <typename T, typename policy_t>
+	class compact_optional
+	{
+	public:
+		using value_type = T;
+		using policy_type = policy_t;
+
+		constexpr compact_optional() noexcept : val{}
+		{
+			policy_t::set_empty(val);
+		}
+
+		constexpr compact_optional(std::nullopt_t) noexcept : compact_optional() {}
+
+		// Storing the empty value itself gives an empty optional
+		constexpr compact_optional(const T& value) noexcept(std::is_nothrow_copy_constructible_v<T>) : val(value) {}
+
+		constexpr compact_optional& operator=(std::nullopt_t) noexcept
+		{
+			reset();
+			return *this;
+		}
+
+		constexpr compact_optional& operator=(const T& value)
+		{
+			val = value;
+			return *this;
+		}
+
+		template <typename ... params_t>
+		constexpr T& emplace(params_t&& ... params)
+		{
+			val = T(std::forward<params_t>(params)...);
+			return val;
+		}
+
+		constexpr void reset() noexcept
+		{
+			policy_t::set_empty(val);
+		}
+
+		[[nodiscard]] constexpr bool has_value() const noexcept { return policy_t::is_empty(val) == false; }
+		[[nodiscard]] constexpr explicit operator bool() const noexcept { return has_value(); }
+
+		[[nodiscard]] constexpr T& value()
+		{
+			if (has_value() == false)
+			{
+				throw std::bad_optional_access();
+			}
+			return val;
+		}
+
+		[[nodiscard]] constexpr const T& value() const
+		{
+			if (has_value() == false)
+			{
+				throw std::bad_optional_access();
+			}
+			return val;
+		}
+
+		template <typename default_t>
+		[[nodiscard]] constexpr T value_or(default_t&& fallback) const
+		{
+			return has_value() ? val : static_cast<T>(std::forward<default_t>(fallback));
+		}
+
+		constexpr T& operator*() noexcept { return val; }
+		constexpr const T& operator*() const noexcept { return val; }
+		constexpr T* operator->() noexcept { return &val; }
+		constexpr const T* operator->() const noexcept { return &val; }
+
+		// Calls fun with the value if there is one. A result is wrapped in optional_ex unless it already is an
+		// optional (compact or not)
+		template <typename fun_t>
+		constexpr decltype(auto) apply(fun_t&& fun) const
+		{
+			static_assert(std::is_invocable_v<fun_t, const T&>, "apply must accept const T&, use map for modifiable value");
+			using fun_res_t = std::invoke_result_t<fun_t, const T&>;
+			if constexpr (std::is_same_v<fun_res_t, void>)
+			{
+				if (has_value())
+				{
+					fun(val);
+				}
+			}
+			else
+			{
+				using ret_t = typename __detail::compact_apply_result<fun_res_t>::type;
+				if (has_value())
+				{
+					return ret_t{ fun(val) };
+				}
+
+				return ret_t{};
+			}
+		}
+
+		// map implicitly expects fun_t to modify the result in-place and disregards the return value
+		template <typename fun_t>
+		constexpr decltype(auto) map(fun_t&& fun)
+		{
+			if (has_value())
+			{
+				fun(val);
+			}
+			return *this;
+		}
+
+		template <typename fun_t>
+		constexpr decltype(auto) and_then(fun_t&& fun) const	// call functor has value
+		{
+			return apply(std::forward<fun_t>(fun));
+		}
+
+		template <typename fun_t>
+		constexpr decltype(auto) or_else(fun_t&& fun)	// call functor if no value
+		{
+			if (has_value() == false)
+			{
+				fun();
+			}
+
+			return *this;
+		}
+
+	private:
+		T val;
+	};
+}
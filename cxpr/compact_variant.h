@@ -0,0 +1,319 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Describes a byte of T that compact_variant may keep its index in (a niche). 'offset' is the position of the
+	// byte in T, npos when there is none. Values from 'first_free' up never appear in that byte while T is valid;
+	// first_free = 0 means T doesn't use the byte at all, like a reserved member (padding isn't enough, copies
+	// don't have to preserve it). Specialize this, or declare niche_offset (and optionally niche_first_free) as
+	// static members:
+	//	 struct fill { uint32_t qty; uint16_t venue; uint8_t side; uint8_t reserved; static constexpr size_t niche_offset = 7; };
+	template <typename T, typename = void>
+	struct niche_traits
+	{
+		static constexpr size_t offset = static_cast<size_t>(-1);
+		static constexpr size_t first_free = 0;
+	};
+
+	namespace __detail
+	{
+		template <typename T, typename = void>
+		constexpr size_t niche_first_free_v = 0;
+
+		template <typename T>
+		constexpr size_t niche_first_free_v<T, std::void_t<decltype(T::niche_first_free)>> = T::niche_first_free;
+	}
+
+	template <typename T>
+	struct niche_traits<T, std::void_t<decltype(T::niche_offset)>>
+	{
+		static constexpr size_t offset = T::niche_offset;
+		static constexpr size_t first_free = __detail::niche_first_free_v<T>;
+	};
+
+	template <>
+	struct niche_traits<bool>
+	{
+		static constexpr size_t offset = 0;
+		static constexpr size_t first_free = 2;
+	};
+
+	namespace __detail
+	{
+		struct niche_layout
+		{
+			static constexpr size_t npos = static_cast<size_t>(-1);
+
+			size_t offset = npos;	// byte holding the index, npos when it is stored after the value instead
+			size_t holder = npos;	// alternative whose own values live in that byte (they're all below 'base')
+			size_t base = 0;		// code of the first alternative that isn't the holder
+		};
+
+		// Every alternative must either declare the same niche byte or end before it, and at most one of them may
+		// use the byte for its own values
+		template <size_t n>
+		constexpr niche_layout find_niche_layout(const size_t (&offsets)[n], const size_t (&first_free)[n],
+			const size_t (&sizes)[n]) noexcept
+		{
+			constexpr size_t npos = niche_layout::npos;
+			size_t offset = npos;
+			for (size_t i = 0; i < n; i++)
+			{
+				if (offsets[i] == npos)
+				{
+					continue;
+				}
+				if (offsets[i] >= sizes[i] || (offset != npos && offsets[i] != offset))
+				{
+					return {};
+				}
+				offset = offsets[i];
+			}
+			if (offset == npos)
+			{
+				return {};
+			}
+
+			size_t holder = npos;
+			for (size_t i = 0; i < n; i++)
+			{
+				if (offsets[i] == npos)
+				{
+					if (sizes[i] > offset)
+					{
+						return {};	// overlaps the byte without saying it's free
+					}
+				}
+				else if (first_free[i] > 0)
+				{
+					if (holder != npos)
+					{
+						return {};
+					}
+					holder = i;
+				}
+			}
+
+			const size_t base = (holder == npos) ? 0 : first_free[holder];
+			const size_t codes = n - ((holder == npos) ? 0 : 1);
+			if (base + codes > 256)
+			{
+				return {};
+			}
+			return { offset, holder, base };
+		}
+
+		template <size_t n>
+		constexpr std::array<uint8_t, 256> make_niche_decoder(niche_layout layout) noexcept
+		{
+			std::array<uint8_t, 256> out{};
+			for (size_t code = 0; code < 256; code++)
+			{
+				if (code < layout.base)
+				{
+					out[code] = static_cast<uint8_t>(layout.holder);
+				}
+				else
+				{
+					const size_t rank = code - layout.base;
+					const size_t idx = (layout.holder != niche_layout::npos && rank >= layout.holder) ? rank + 1 : rank;
+					out[code] = static_cast<uint8_t>(idx < n ? idx : 0);
+				}
+			}
+			return out;
+		}
+
+		// Hands jump_visit mutable references, compact_variant::visit re-stamps the index afterwards
+		template <typename variant_t>
+		struct mutable_alternatives
+		{
+			static constexpr size_t alternative_count = variant_t::alternative_count;
+			variant_t& v;
+
+			size_t index() const noexcept { return v.index(); }
+			constexpr bool valueless_by_exception() const noexcept { return false; }
+
+			template <size_t idx>
+			decltype(auto) get_alternative() const noexcept
+			{
+				return const_cast<typename variant_t::template alternative_t<idx>&>(v.template get_alternative<idx>());
+			}
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// std::variant replacement for arrays of small trivially copyable values. The index is the smallest
+	// unsigned type that fits, and when the alternatives describe a niche (see niche_traits) it is kept inside
+	// the value itself, so the variant is exactly as large as its largest alternative:
+	//	 cxpr::compact_variant<fill, cancel, heartbeat> event = fill{ 100, 2, 'B' };	// 8 bytes, std::variant: 12
+	//	 event.visit([](const auto& e) { handle(e); });
+	// Values can be read through get/get_if/visit. Mutable access is only given by visit, which writes the
+	// index back afterwards in case the visitor overwrote a niche byte
+	template <typename ... types_t>
+	class compact_variant
+	{
+		static_assert(sizeof...(types_t) > 0, "compact_variant needs at least one alternative");
+		static_assert((std::is_trivially_copyable_v<types_t> && ...), "compact_variant alternatives must be trivially copyable");
+		static_assert((std::is_trivially_destructible_v<types_t> && ...), "compact_variant alternatives must be trivially destructible");
+
+		static constexpr size_t offsets[] = { niche_traits<types_t>::offset... };
+		static constexpr size_t first_free[] = { niche_traits<types_t>::first_free... };
+		static constexpr size_t sizes[] = { (std::is_empty_v<types_t> ? 0 : sizeof(types_t))... }; // empty types hold no bytes
+		static constexpr __detail::niche_layout layout = __detail::find_niche_layout(offsets, first_free, sizes);
+
+	public:
+		using my_t = compact_variant<types_t...>;
+		using index_t = std::conditional_t<(sizeof...(types_t) <= 256), uint8_t, uint16_t>;
+
+		template <size_t idx>
+		using alternative_t = std::tuple_element_t<idx, std::tuple<types_t...>>;
+
+		static constexpr size_t alternative_count = sizeof...(types_t);
+		static constexpr bool uses_niche = layout.offset != __detail::niche_layout::npos;
+
+		template <typename T>
+		static constexpr size_t index_of = __detail::type_index_of<T, types_t...>();
+
+		template <typename T>
+		static constexpr bool contains = index_of<T> != alternative_count;
+
+		// Holds a value-initialized first alternative, like std::variant
+		compact_variant() noexcept
+		{
+			emplace<0>();
+		}
+
+		template <typename T, typename = std::enable_if_t<contains<T> && !std::is_same_v<std::decay_t<T>, my_t>>>
+		compact_variant(const T& value) noexcept
+		{
+			emplace<index_of<T>>(value);
+		}
+
+		template <typename T, typename = std::enable_if_t<contains<T> && !std::is_same_v<std::decay_t<T>, my_t>>>
+		my_t& operator=(const T& value) noexcept
+		{
+			emplace<index_of<T>>(value);
+			return *this;
+		}
+
+		template <size_t idx, typename ... params_t>
+		const alternative_t<idx>& emplace(params_t&& ... params)
+		{
+			auto* created = new (storage.bytes) alternative_t<idx>(std::forward<params_t>(params)...);
+			stamp(idx);
+			return *created;
+		}
+
+		template <typename T, typename ... params_t>
+		const T& emplace(params_t&& ... params)
+		{
+			static_assert(contains<T>, "type is not an alternative of the compact_variant");
+			return emplace<index_of<T>>(std::forward<params_t>(params)...);
+		}
+
+		[[nodiscard]] size_t index() const noexcept
+		{
+			if constexpr (uses_niche && layout.holder == __detail::niche_layout::npos)
+			{
+				return storage.bytes[layout.offset]; // the byte is the index
+			}
+			else if constexpr (uses_niche)
+			{
+				return decoder[storage.bytes[layout.offset]];
+			}
+			else
+			{
+				return storage.idx;
+			}
+		}
+
+		// Trivially copyable alternatives can't throw half way through a change
+		[[nodiscard]] constexpr bool valueless_by_exception() const noexcept { return false; }
+
+		template <typename T>
+		[[nodiscard]] bool holds_alternative() const noexcept
+		{
+			return index() == index_of<T>;
+		}
+
+		template <typename T>
+		[[nodiscard]] const T* get_if() const noexcept
+		{
+			static_assert(contains<T>, "type is not an alternative of the compact_variant");
+			return holds_alternative<T>() ? &get_alternative<index_of<T>>() : nullptr;
+		}
+
+		// Throws std::bad_variant_access if T isn't the held alternative
+		template <typename T>
+		[[nodiscard]] const T& get() const
+		{
+			if (holds_alternative<T>() == false)
+			{
+				throw std::bad_variant_access();
+			}
+			return get_alternative<index_of<T>>();
+		}
+
+		// Unchecked access used by jump_visit
+		template <size_t idx>
+		[[nodiscard]] const alternative_t<idx>& get_alternative() const noexcept
+		{
+			return *std::launder(reinterpret_cast<const alternative_t<idx>*>(storage.bytes));
+		}
+
+		template <typename fun_t>
+		decltype(auto) visit(fun_t&& fun) const
+		{
+			return cxpr::jump_visit(std::forward<fun_t>(fun), *this);
+		}
+
+		template <typename fun_t>
+		decltype(auto) visit(fun_t&& fun)
+		{
+			const restamp_on_exit restamp{ *this, index() };
+			return cxpr::jump_visit(std::forward<fun_t>(fun), __detail::mutable_alternatives<my_t>{ *this });
+		}
+
+	private:
+		struct niche_storage
+		{
+			alignas(types_t...) unsigned char bytes[max_size<types_t...>::value];
+		};
+
+		struct indexed_storage
+		{
+			alignas(types_t...) unsigned char bytes[max_size<types_t...>::value];
+			index_t idx;
+		};
+
+		struct restamp_on_exit
+		{
+			my_t& self;
+			size_t idx;
+			~restamp_on_exit() { self.stamp(idx); }
+		};
+
+		static constexpr std::array<uint8_t, 256> decoder = __detail::make_niche_decoder<alternative_count>(layout);
+
+		std::conditional_t<uses_niche, niche_storage, indexed_storage> storage;
+
+		void stamp(size_t idx) noexcept
+		{
+			if constexpr (uses_niche)
+			{
+				if (idx != layout.holder)
+				{
+					const size_t rank = (layout.holder != __detail::niche_layout::npos && idx > layout.holder) ? idx - 1 : idx;
+					storage.bytes[layout.offset] = static_cast<unsigned char>(layout.base + rank);
+				}
+			}
+			else
+			{
+				storage.idx = static_cast<index_t>(idx);
+			}
+		}
+	};
+}
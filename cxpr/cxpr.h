@@ -8,25 +8,59 @@
 //////////////////////////////////////////////////////////////////////////
 // Required library includes
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace cxpr
 {
 	using hash_t = unsigned long long;
 }
 
+#include "hash_utils.h"
 #include "type_hash.h"
 #include "variadic_utils.h"
 #include "static_pair.h"
 #include "optional_ex.h"
 #include "cxpr_algo.h"
+#include "simd_utils.h"
 #include "array_utils.h"
 #include "fixed_vector.h"
 #include "fixed_string.h"
+#include "string_utils.h"
+#include "utf_utils.h"
+#include "parse_utils.h"
+#include "literal.h"
 #include "static_map.h"
+#include "string_interner.h"
 #include "tuple_utils.h"
+#include "packed_tuple.h"
+#include "serialize.h"
+#include "type_map.h"
+#include "fast_any.h"
+#include "inplace_function.h"
+#include "event_bus.h"
 #include "variant_utils.h"
+#include "poly_collection.h"
+#include "compact_variant.h"
+#include "compact_optional.h"
+#include "record_parser.h"
 
 //#undef PARAM_PACK_UTILS
 //#undef param_pack_t
@@ -0,0 +1,136 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	// Subscriber record, a plain function pointer plus the object it should be called with
+	template <typename event_t>
+	struct event_subscriber
+	{
+		using invoke_t = void(*)(void* context, const event_t& event);
+
+		invoke_t invoke = nullptr;
+		void* context = nullptr;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Publish/subscribe over a fixed set of event types. Each type gets up to max_subscribers slots in flat
+	// storage, so subscribing never allocates (a full list throws std::out_of_range like fixed_vector).
+	//	 cxpr::event_bus<cxpr::typeset<order_placed, order_filled>> bus;
+	//	 bus.subscribe<order_filled>(risk);						// calls risk(const order_filled&)
+	//	 bus.publish(order_filled{...});							// list is picked during compile
+	//	 bus.publish(cxpr::typehash_v<order_filled>, &raw);		// type-erased, through a jump table
+	// Subscribers are called in the order they subscribed. Objects passed to subscribe must outlive their
+	// subscription. The event types are checked with assert_unique_typehashes (through type_map), so a hash
+	// names one event type
+	template <typename set_t, size_t max_subscribers = 8>
+	class event_bus;
+
+	template <template <typename ...> class set_t, typename ... events_t, size_t max_subscribers>
+	class event_bus<set_t<events_t...>, max_subscribers>
+	{
+	public:
+		using types = typeset<events_t...>;
+		using index_map_t = type_map<types, uint8_t>;
+
+		template <typename event_t>
+		using subscriber_list_t = fixed_vector<event_subscriber<event_t>, max_subscribers>;
+
+		template <typename event_t>
+		static constexpr bool handles = index_map_t::template contains<event_t>;
+
+		// Raw form, invoke(context, event)
+		template <typename event_t>
+		void subscribe(typename event_subscriber<event_t>::invoke_t invoke, void* context = nullptr)
+		{
+			list<event_t>().push_back(event_subscriber<event_t>{ invoke, context });
+		}
+
+		// Any object with operator()(const event_t&), including lambdas
+		template <typename event_t, typename handler_t>
+		void subscribe(handler_t& handler)
+		{
+			static_assert(std::is_invocable_v<handler_t&, const event_t&>, "handler must be callable with const event_t&");
+			subscribe<event_t>([](void* context, const event_t& event)
+			{
+				(*static_cast<handler_t*>(context))(event);
+			}, const_cast<void*>(static_cast<const void*>(&handler)));
+		}
+
+		// Removes every subscription to event_t made with this context/handler, returns how many were removed
+		template <typename event_t>
+		size_t unsubscribe(const void* context)
+		{
+			auto& subscribers = list<event_t>();
+			size_t kept = 0;
+			for (size_t i = 0; i < subscribers.size(); i++)
+			{
+				if (subscribers[i].context != context)
+				{
+					subscribers[kept++] = subscribers[i];
+				}
+			}
+
+			const size_t removed = subscribers.size() - kept;
+			for (size_t i = 0; i < removed; i++)
+			{
+				subscribers.pop_back();
+			}
+			return removed;
+		}
+
+		template <typename event_t>
+		void publish(const event_t& event) const
+		{
+			for (const auto& subscriber : list<std::decay_t<event_t>>())
+			{
+				subscriber.invoke(subscriber.context, event);
+			}
+		}
+
+		// Type-erased publish for events that arrive as a typehash_v plus a pointer (ie from a queue).
+		// Returns false if the hash isn't one of the bus' event types
+		bool publish(cxpr::hash_t typehash, const void* event) const
+		{
+			const size_t idx = index_map_t::find_index(typehash);
+			if (idx == index_map_t::npos)
+			{
+				return false;
+			}
+
+			jump_table[idx](*this, event);
+			return true;
+		}
+
+		template <typename event_t>
+		[[nodiscard]] size_t subscriber_count() const noexcept { return list<event_t>().size(); }
+
+	private:
+		using publisher_t = void(*)(const event_bus&, const void*);
+
+		template <typename event_t>
+		static void publish_erased(const event_bus& bus, const void* event)
+		{
+			bus.publish(*static_cast<const event_t*>(event));
+		}
+
+		static constexpr publisher_t jump_table[] = { &publish_erased<events_t>... };
+
+		std::tuple<subscriber_list_t<events_t>...> subscribers;
+
+		template <typename event_t>
+		subscriber_list_t<std::decay_t<event_t>>& list() noexcept
+		{
+			static_assert(handles<event_t>, "event type is not part of the event_bus");
+			return std::get<index_map_t::template index_of<event_t>>(subscribers);
+		}
+
+		template <typename event_t>
+		const subscriber_list_t<std::decay_t<event_t>>& list() const noexcept
+		{
+			static_assert(handles<event_t>, "event type is not part of the event_bus");
+			return std::get<index_map_t::template index_of<event_t>>(subscribers);
+		}
+	};
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		// Per-type operations for the type-erased containers, one static instance per stored type
+		struct any_vtable
+		{
+			cxpr::hash_t type;
+			void (*destroy)(void* obj) noexcept;
+			void (*copy)(void* dst, const void* src);
+			void (*move)(void* dst, void* src) noexcept;
+			bool trivial;	// copy and move are a plain memcpy, destroy does nothing
+		};
+
+		template <typename T>
+		struct any_vtable_for
+		{
+			static void destroy(void* obj) noexcept { static_cast<T*>(obj)->~T(); }
+			static void copy(void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); }
+			static void move(void* dst, void* src) noexcept
+			{
+				new (dst) T(std::move(*static_cast<T*>(src)));
+				static_cast<T*>(src)->~T();
+			}
+
+			static constexpr any_vtable value = { typehash_v<T>, &destroy, &copy, &move,
+				std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> };
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// std::any replacement that never allocates: values live in 'capacity' bytes of inline storage, and a
+	// type that doesn't fit (or needs more than 'align' alignment) is a compile error. copy/move/destroy come
+	// from a static per-type table, and type checks compare its address instead of going through RTTI.
+	//	 cxpr::fast_any<32> attr = std::string_view("gzip");
+	//	 if (auto* encoding = attr.get<std::string_view>()) {...}
+	// Moving from a fast_any leaves it empty. Stored types must be copy constructible and nothrow movable
+	template <size_t capacity, size_t align = alignof(std::max_align_t)>
+	class fast_any
+	{
+	public:
+		using my_t = fast_any<capacity, align>;
+
+		template <typename T>
+		static constexpr bool fits_v = sizeof(T) <= capacity && align % alignof(T) == 0;
+
+		fast_any() noexcept = default;
+
+		template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, my_t>>>
+		fast_any(T&& value)
+		{
+			emplace<std::decay_t<T>>(std::forward<T>(value));
+		}
+
+		fast_any(const my_t& other)
+		{
+			if (other.vtable != nullptr)
+			{
+				other.vtable->copy(storage, other.storage);
+				vtable = other.vtable;
+			}
+		}
+
+		fast_any(my_t&& other) noexcept
+		{
+			take(other);
+		}
+
+		~fast_any() { reset(); }
+
+		my_t& operator=(const my_t& other)
+		{
+			if (this != &other)
+			{
+				my_t copy(other); // a throwing copy leaves us untouched
+				reset();
+				take(copy);
+			}
+			return *this;
+		}
+
+		my_t& operator=(my_t&& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+				take(other);
+			}
+			return *this;
+		}
+
+		template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, my_t>>>
+		my_t& operator=(T&& value)
+		{
+			emplace<std::decay_t<T>>(std::forward<T>(value));
+			return *this;
+		}
+
+		template <typename T, typename ... params_t>
+		T& emplace(params_t&& ... params)
+		{
+			static_assert(sizeof(T) <= capacity, "type is too large for this fast_any, increase the capacity");
+			static_assert(align % alignof(T) == 0, "type needs more alignment than this fast_any provides");
+			static_assert(std::is_copy_constructible_v<T>, "fast_any values must be copy constructible");
+			static_assert(std::is_nothrow_move_constructible_v<T>, "fast_any values must be nothrow movable");
+
+			// params may refer to the value we currently hold, so build the new one before destroying it
+			T value(std::forward<params_t>(params)...);
+			reset();
+			T* created = new (storage) T(std::move(value));
+			vtable = &__detail::any_vtable_for<T>::value;
+			return *created;
+		}
+
+		void reset() noexcept
+		{
+			if (vtable != nullptr)
+			{
+				vtable->destroy(storage);
+				vtable = nullptr;
+			}
+		}
+
+		[[nodiscard]] bool has_value() const noexcept { return vtable != nullptr; }
+
+		// typehash_v of the held type, 0 when empty. Only a hint, different types can share a hash (see typehash_v)
+		[[nodiscard]] cxpr::hash_t type() const noexcept { return vtable != nullptr ? vtable->type : 0; }
+
+		template <typename T>
+		[[nodiscard]] bool is() const noexcept { return vtable == &__detail::any_vtable_for<T>::value; }
+
+		// Pointer to the value if it's a T, nullptr otherwise
+		template <typename T>
+		[[nodiscard]] T* get() noexcept
+		{
+			return is<T>() ? std::launder(reinterpret_cast<T*>(storage)) : nullptr;
+		}
+
+		template <typename T>
+		[[nodiscard]] const T* get() const noexcept
+		{
+			return is<T>() ? std::launder(reinterpret_cast<const T*>(storage)) : nullptr;
+		}
+
+		// Reference to the value, throws std::runtime_error if it isn't a T
+		template <typename T>
+		[[nodiscard]] T& cast()
+		{
+			if (is<T>() == false)
+			{
+				throw std::runtime_error("fast_any holds a different type");
+			}
+			return *get<T>();
+		}
+
+		template <typename T>
+		[[nodiscard]] const T& cast() const
+		{
+			if (is<T>() == false)
+			{
+				throw std::runtime_error("fast_any holds a different type");
+			}
+			return *get<T>();
+		}
+
+	private:
+		const __detail::any_vtable* vtable = nullptr;
+		alignas(align) unsigned char storage[capacity];
+
+		void take(my_t& other) noexcept
+		{
+			if (other.vtable != nullptr)
+			{
+				other.vtable->move(storage, other.storage);
+				vtable = other.vtable;
+				other.vtable = nullptr;
+			}
+		}
+	};
+}
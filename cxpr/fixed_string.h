@@ -8,6 +8,53 @@ namespace cxpr
 	{
 		template <typename char_t>
 		static constexpr char_t offset_v = char_t('Z') - char_t('z');
+
+		// Returns how many base 2^digit_bits digits are needed to represent value
+		template <size_t digit_bits>
+		constexpr size_t digits_needed(size_t value) noexcept
+		{
+			size_t digits = 0;
+			while (value != 0)
+			{
+				value = value >> (digit_bits - 1) >> 1;
+				digits++;
+			}
+			return digits;
+		}
+
+		template <typename T>
+		static constexpr bool is_char_type_v = std::is_same_v<T, char> || std::is_same_v<T, wchar_t>
+			|| std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+		static constexpr char digit_pairs[] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		// Writes value as decimal digits ending right before 'out', two digits per step from the pair table.
+		// Returns a pointer to the first digit
+		constexpr char* format_unsigned(char* out, uint64_t value) noexcept
+		{
+			while (value >= 100)
+			{
+				const size_t idx = static_cast<size_t>(value % 100) * 2;
+				value /= 100;
+				*--out = digit_pairs[idx + 1];
+				*--out = digit_pairs[idx];
+			}
+
+			if (value >= 10)
+			{
+				const size_t idx = static_cast<size_t>(value) * 2;
+				*--out = digit_pairs[idx + 1];
+				*--out = digit_pairs[idx];
+			}
+			else
+			{
+				*--out = static_cast<char>('0' + value);
+			}
+			return out;
+		}
 	}
 
 	template <typename data_t,
@@ -41,11 +88,27 @@ namespace cxpr
 	}
 
 
+	// Lowercases ASCII letters in place, a block at a time. Works on anything with mutable contiguous storage
+	// (std::string, basic_fixed_string, std::array...)
+	template <typename string_t>
+	constexpr string_t& to_lower_inplace(string_t& str) noexcept
+	{
+		cxpr::lower_case_copy(std::data(str), std::data(str), std::size(str));
+		return str;
+	}
+
+	template <typename string_t>
+	constexpr string_t& to_upper_inplace(string_t& str) noexcept
+	{
+		cxpr::upper_case_copy(std::data(str), std::data(str), std::size(str));
+		return str;
+	}
+
 	template <typename out_t>
 	[[nodiscard]] constexpr decltype(auto) to_lower(std::string_view in) noexcept
 	{
-		out_t ret{};
-		std::transform(std::begin(in), std::end(in), std::back_inserter(ret), std::tolower);
+		out_t ret(in);
+		to_lower_inplace(ret);
 		return ret;
 	}
 
@@ -55,11 +118,12 @@ namespace cxpr
 		typename overrun_behavior>
 		[[nodiscard]] constexpr decltype(auto) to_lower(const basic_fixed_string<data_t, max_sz, transform, overrun_behavior>& in) noexcept
 	{
-		basic_fixed_string<data_t, max_sz, transform, overrun_behavior> ret{};
-		std::transform(std::begin(in), std::end(in), std::back_inserter(ret), std::tolower);
+		basic_fixed_string<data_t, max_sz, transform, overrun_behavior> ret(in);
+		to_lower_inplace(ret);
 		return ret;
 	}
 
+	// Case-invariant 64 bit hash (see __detail::hash_bytes), gives the same value at compile and run time
 	[[nodiscard]] constexpr cxpr::hash_t hash_invariant(std::string_view in) noexcept
 	{
 		if (in.size() == 0)
@@ -67,20 +131,7 @@ namespace cxpr
 			return 0;
 		}
 
-		// djb2 hash by Dan Bernstein
-		auto it = std::begin(in);
-		const auto endIt = std::end(in);
-
-		cxpr::hash_t hash = 5381;
-
-		while (it != endIt)
-		{
-			// this is expected to overflow,  VS will still throw 4307 if it does though, known
-			// VS issue that suppressing doesn't fix, fix in the future if they patch
-			hash = ((hash << 5) + hash) + cx_tolower(*it++);
-		}
-
-		return hash;
+		return __detail::hash_bytes<true>(in.data(), in.size());
 	}
 
 	//////////////////////////////////////////////////////////////////////////
@@ -120,14 +171,17 @@ namespace cxpr
 	template <> struct str_terminator<char> { static constexpr char value() { return '\0'; } };
 	template <> struct str_terminator<wchar_t> { static constexpr wchar_t value() { return L'\0'; } };
 	template <> struct str_terminator<char16_t> { static constexpr wchar_t value() { return char16_t{}; } }; // is this right?
+	template <> struct str_terminator<char32_t> { static constexpr char32_t value() { return char32_t{}; } };
 
 	//////////////////////////////////////////////////////////////////////////
 	// Implementation of a fixed-size string buffer. 
 	// The contained string will always be null-terminated and can be [0, max_capacity) in length
 	// The string is guaranteed to be contiguous in memory and uses std::array as the underlying container
-	// For small strings (ie the size can be indexed by a single data_t) the implementation will use
-	// indexing for push_back/emplace/size/etc. Larger strings will function similar to a const char* and
-	// use a linear search for the the terminator character to determine size 
+	// The final character of the buffer stores the remaining capacity (max_sz - size) instead of a plain
+	// terminator. A full string has nothing remaining, so the final character doubles as the null terminator
+	// and size/emplace/push_back are O(1) regardless of capacity. When the remaining capacity doesn't fit in
+	// a single data_t, the final character is set to 'length_marker' and the count is stored in the 
+	// 'length_width' characters in front of it, which are guaranteed to be unused while that much is remaining
 	template <typename data_t,
 		size_t max_capacity,
 		typename transform = no_transform,
@@ -156,41 +210,68 @@ namespace cxpr
 		static constexpr bool throw_on_overrun = std::is_same_v<std::decay_t<overrun_behavior>, overrun_behavior_throw>;
 		static constexpr bool trunc_on_overrun = std::is_same_v<std::decay_t<overrun_behavior> , overrun_behavior_trunc>;
 		static constexpr data_t terminator_value = str_terminator<data_t>::value();
+		static constexpr size_t npos = std::basic_string_view<data_t>::npos;
 
-		// If 'use_emplace_indexed' is true, then the final character will be used as a 1-based index into the container
-		// This eliminates linear searching for size/emplace/push_back and replaces them with the approprate indexed operations
-		// The index is 1-base as opposed to 0-base b/c a size of 0 would also indicate the terminated value for char '\0'
-		static constexpr bool use_emplace_indexed = std::numeric_limits<data_t>::max() >= max_capacity;
+		// The remaining capacity is packed into the buffer as unsigned data_t digits
+		using length_t = std::make_unsigned_t<data_t>;
+		static constexpr size_t length_bits = sizeof(data_t) * CHAR_BIT;
+		static constexpr length_t length_marker = std::numeric_limits<length_t>::max();
+
+		// If 'use_inline_length' is true the remaining capacity always fits in the final character, otherwise the
+		// 'length_width' characters in front of it hold the count while it is >= length_marker
+		static constexpr bool use_inline_length = max_sz < length_marker;
+		static constexpr size_t length_width = use_inline_length ? 0 : __detail::digits_needed<length_bits>(max_sz);
+		static_assert(use_inline_length || length_width < length_marker, "remaining capacity must not overlap the string");
 
 		constexpr basic_fixed_string()					noexcept : container{}, terminator{terminator_value}{
-			if constexpr (use_emplace_indexed) { terminator = 1; }
+			set_size(0);
 		}
 		constexpr basic_fixed_string(const my_t& other) noexcept : container(other.container), terminator{ other.terminator } {}
 		constexpr basic_fixed_string(my_t&& other)		noexcept : container(other.container), terminator{ other.terminator } {}
 		constexpr basic_fixed_string(const std::basic_string_view<data_t> str) noexcept : container{}
 		{
-			assign(str.begin(), str.cend());
+			assign(str.data(), str.data() + str.size());
 		}
 
 		constexpr const_pointer c_str() const noexcept { return &container[0]; }
 		constexpr const_pointer data() const noexcept { return &container[0]; }
-		[[nodiscard]] constexpr cxpr::hash_t hash_code() const noexcept { return hash_invariant(&container[0]); }
-		[[nodiscard]] constexpr cxpr::hash_t hash()		 const noexcept { return hash_invariant(&container[0]); }
+		// writable access to [0, size()), writing a null or past the end breaks the stored size
+		constexpr pointer data() noexcept { return &container[0]; }
+		[[nodiscard]] constexpr cxpr::hash_t hash_code() const noexcept { return hash(); }
+		[[nodiscard]] constexpr cxpr::hash_t hash()		 const noexcept { return hash_invariant(*this); }
 		[[nodiscard]] constexpr bool operator<(const my_t& other) const noexcept
 		{
+			const size_t idx = block_mismatch(other);
 			const size_t sz = std::min(size(), other.size());
-			return traits_t::compare(c_str(), other.c_str(), sz) < 0;
+			if (idx < sz)
+			{
+				return traits_t::lt(container[idx], other.container[idx]);
+			}
+			// common prefix matches (the mismatch was past the shorter string or in the stored sizes)
+			return size() < other.size();
+		}
+
+		// Both buffers are zero past the string and store the size the same way, so equal strings are
+		// bitwise equal and the whole buffer can be compared in fixed-size blocks
+		[[nodiscard]] constexpr bool operator==(const my_t& other) const noexcept
+		{
+			return block_mismatch(other) == max_capacity;
+		}
+
+		[[nodiscard]] constexpr bool operator!=(const my_t& other) const noexcept
+		{
+			return !(*this == other);
 		}
 
 		constexpr my_t& operator=(const my_t& other) noexcept
 		{
-			assign(other.begin(), other.end());
+			assign(other.data(), other.data() + other.size());
 			return *this;
 		}
 
 		constexpr my_t& operator=(const std::string& newData) noexcept
 		{
-			assign(newData.begin(), newData.end());
+			assign(newData.data(), newData.data() + newData.size());
 			return *this;
 		}
 
@@ -207,34 +288,24 @@ namespace cxpr
 		constexpr my_t& operator=(
 			const basic_fixed_string<data_t, max_sz, other_transform_t, other_overrun_t>& other) noexcept
 		{
-			assign(other.begin(), other.begin() + other.size());
+			assign(other.data(), other.data() + other.size());
 			return *this;
 		}
 
 		constexpr decltype(auto) begin() noexcept { return container.begin(); }
 		constexpr decltype(auto) begin() const noexcept { return container.begin(); }
-		constexpr decltype(auto) end()	 noexcept { return container.end() + size(); }
+		constexpr decltype(auto) end()	 noexcept { return container.begin() + size(); }
 		constexpr decltype(auto) end()	 const noexcept { return container.begin() + size(); }
 		constexpr size_t capacity() const noexcept { return max_sz; }
 		constexpr size_t size()			 const noexcept { 
-			if constexpr (use_emplace_indexed) {
-				if (terminator == terminator_value){
-					return max_sz;
-				}
-				return static_cast<size_t>(terminator) - 1;
-			}
-			else
-			{
-				return traits_t::length(data());
-			}
+			return max_sz - remaining();
 		}
 		constexpr void clear() {
 			for (auto& it : container) {
 				it = terminator_value;
 			}
-			if constexpr (use_emplace_indexed) {
-				terminator = 1;
-			}
+			terminator = terminator_value;
+			set_size(0);
 		}
 
 		constexpr operator std::basic_string_view<data_t>() const
@@ -248,116 +319,276 @@ namespace cxpr
 			const auto rsize = r.size();
 			if (size() == rsize)
 			{
-				equal = traits_t::compare(data(), r.data(), rsize) == 0;
+				equal = cxpr::mismatch_index(data(), r.data(), rsize) == rsize;
 			}
 
 			return equal;
 		}
 
+		constexpr bool operator!=(const std::basic_string_view<data_t> r) const
+		{
+			return !(*this == r);
+		}
+
+		[[nodiscard]] constexpr size_t find(data_t ch, size_t pos = 0) const noexcept
+		{
+			const size_t sz = size();
+			if (pos >= sz)
+			{
+				return npos;
+			}
+
+			const size_t found = cxpr::find_index(data() + pos, sz - pos, ch);
+			return found == sz - pos ? npos : pos + found;
+		}
+
+		[[nodiscard]] constexpr size_t find(const std::basic_string_view<data_t> needle, size_t pos = 0) const noexcept
+		{
+			const size_t sz = size();
+			if (pos > sz)
+			{
+				return npos;
+			}
+
+			const size_t found = cxpr::find_index(data() + pos, sz - pos, needle.data(), needle.size());
+			return found == sz - pos && needle.size() != 0 ? npos : pos + found;
+		}
+
+		[[nodiscard]] constexpr bool starts_with(const std::basic_string_view<data_t> prefix) const noexcept
+		{
+			const size_t prefixSz = prefix.size();
+			return prefixSz <= size() && cxpr::mismatch_index(data(), prefix.data(), prefixSz) == prefixSz;
+		}
+
 		void push_back(const data_t& _Val) {
 			emplace_back(_Val);
 		}
 
 		void push_back(data_t&& _Val) {
-			emplace_back(_STD move(_Val));
+			emplace_back(std::move(_Val));
 		}
 
-		template <class val_t>
-		void emplace_back_indexed(val_t&& _Val) {
-			if (terminator == terminator_value){
-				if constexpr (throw_on_overrun) {
-					throw std::runtime_error("string too small for contents, aborting assignment");
-				}
+		//////////////////////////////////////////////////////////////////////////
+		// append, all overloads run the new characters through transform and follow overrun_behavior, 
+		// nothing is allocated
 
-				// pools closed, go home
-				return;
-			}
+		constexpr my_t& append(const std::basic_string_view<data_t> str)
+		{
+			append_range(str.data(), str.data() + str.size());
+			return *this;
+		}
 
-			// indexed
-			container[static_cast<size_t>(terminator) -1] = std::move(_Val);
-			terminator++;
-			if (terminator >= max_capacity){
-				terminator = terminator_value;
-			}
+		constexpr my_t& append(data_t ch)
+		{
+			append_range(&ch, &ch + 1);
+			return *this;
 		}
 
-		template <class val_t>
-		void emplace_back(val_t&& _Val) {
+		// integers are written as decimal, two digits at a time
+		template <typename int_t, 
+			std::enable_if_t<std::is_integral_v<int_t> && !__detail::is_char_type_v<int_t> && !std::is_same_v<int_t, bool>, int> = 0>
+		constexpr my_t& append(int_t value)
+		{
+			using uint_t = std::make_unsigned_t<int_t>;
+			char buffer[24] = {};
+			char* const bufferEnd = buffer + sizeof(buffer);
 
-			if constexpr (use_emplace_indexed) {
-				// we're small enough to use the end value as an index
-				emplace_back_indexed(std::move(_Val));
+			auto magnitude = static_cast<uint_t>(value);
+			if constexpr (std::is_signed_v<int_t>)
+			{
+				if (value < 0)
+				{
+					magnitude = static_cast<uint_t>(uint_t{ 0 } - magnitude);
+				}
 			}
-			else {	// traditional iterate and check vs null terminator
-				auto it = &container[0];
-				auto endIt = &terminator;
-				while(it != endIt){
-					if (*it == terminator){
-						*it = std::move(_Val);
-						// overrun the end iterator is fine since it's a data_t and already '\0'
-						(++it) = terminator_value;
-						break;
-					}
-					++it;
+
+			char* first = __detail::format_unsigned(bufferEnd, magnitude);
+			if constexpr (std::is_signed_v<int_t>)
+			{
+				if (value < 0)
+				{
+					*--first = '-';
 				}
+			}
 
+			append_range(static_cast<const char*>(first), static_cast<const char*>(bufferEnd));
+			return *this;
+		}
+
+		// floats go through std::to_chars, shortest round-trip form by default. Not constexpr since to_chars isn't
+		template <typename float_t, std::enable_if_t<std::is_floating_point_v<float_t>, int> = 0>
+		my_t& append(float_t value)
+		{
+			char buffer[64];
+			const auto res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			return append_chars(buffer, res);
+		}
+
+		template <typename float_t, std::enable_if_t<std::is_floating_point_v<float_t>, int> = 0>
+		my_t& append(float_t value, std::chars_format format, int precision)
+		{
+			// room for any in-capacity result plus the longest fixed form of a double, so failure means it can't fit
+			char buffer[max_sz + 330];
+			const auto res = std::to_chars(buffer, buffer + sizeof(buffer), value, format, precision);
+			return append_chars(buffer, res);
+		}
+
+		template <class val_t>
+		void emplace_back(val_t&& _Val) {
+			const size_t sz = size();
+			if (sz == max_sz) {
 				if constexpr (throw_on_overrun) {
-					if (it == endIt) {
-						// failed to set
-						throw std::runtime_error("string too small for contents, aborting assignment");
-					}
+					throw std::runtime_error("string too small for contents, aborting assignment");
 				}
+
+				// pools closed, go home
+				return;
 			}
+
+			container[sz] = std::forward<val_t>(_Val);
+			set_size(sz + 1);
 		}
 
 	private:
 		// Memory layout, we don't expose the terminator value to the user and forcefully set it during creation
-		// this is possible b/c the end value can only ever be '\0' due to strings always having to be null terminated
+		// this is possible b/c the end value is only ever '\0' once the string is full, before that it
+		// holds the remaining capacity (see set_size)
 		union
 		{
 			const data_t debug[max_sz - 1];
 			container_t container;
 		};
-		data_t terminator = terminator_value; // not const since we might index with it
+		data_t terminator = terminator_value; // not const since we store the remaining capacity in it
 
-		template <typename iterator_t>
-		constexpr void assign(iterator_t it, iterator_t end)
+		// Index of the first differing character across the entire buffer (including the terminator), 
+		// or max_capacity if the buffers are identical
+		constexpr size_t block_mismatch(const my_t& other) const noexcept
 		{
-			clear();
-			auto distance = std::distance(it, end);
+			if (__detail::is_constant_evaluated() == false)
+			{
+				static_assert(sizeof(my_t) == sizeof(data_t) * max_capacity, "buffer must be contiguous");
+				const auto bytes = __detail::vector_mismatch(reinterpret_cast<const char*>(this),
+					reinterpret_cast<const char*>(&other), sizeof(my_t));
+				return bytes / sizeof(data_t);
+			}
 
-			if constexpr (trunc_on_overrun)
+			const size_t idx = __detail::scalar_mismatch(data(), other.data(), max_sz);
+			if (idx != max_sz || terminator != other.terminator)
 			{
-				if (distance > max_sz)
-				{
-					end = it + max_sz;
+				return idx;
+			}
+			return max_capacity;
+		}
+
+		constexpr size_t remaining() const noexcept
+		{
+			const auto tail = static_cast<length_t>(terminator);
+			if constexpr (use_inline_length == false)
+			{
+				if (tail == length_marker)
+				{	// digits are stored least significant first, ending right before the terminator
+					size_t count = 0;
+					for (size_t i = max_sz; i-- > max_sz - length_width;)
+					{
+						count = (count << (length_bits - 1) << 1) | static_cast<length_t>(container[i]);
+					}
+					return count;
 				}
+			}
+
+			return tail;
+		}
 
-				auto containerOut = begin();
-				while (it != end)
+		// Stores the size (as the remaining capacity) and keeps everything past the string zeroed
+		constexpr void set_size(size_t newSz) noexcept
+		{
+			size_t count = max_sz - newSz;
+			if constexpr (use_inline_length == false)
+			{
+				const size_t digitsBegin = max_sz - length_width;
+				if (count >= length_marker)
 				{
-					*containerOut++ = transform{}(*it++);
+					for (size_t i = digitsBegin + 1; i <= max_sz; i++)
+					{
+						container[i - 1] = static_cast<data_t>(static_cast<length_t>(count));
+						count = count >> (length_bits - 1) >> 1;
+					}
+					terminator = static_cast<data_t>(length_marker);
+					return;
 				}
 
-				if constexpr (use_emplace_indexed) {
-					const auto newLen = std::min(static_cast<size_t>(distance), static_cast<size_t>(max_sz));
-					terminator = static_cast<decltype(terminator)>(newLen) + 1; // index can't start at 0 since that's '\0'
-					if (distance >= max_sz){
-						terminator = terminator_value;
+				if (static_cast<length_t>(terminator) == length_marker)
+				{	// moving out of the extended form, scrub whatever digits the string didn't overwrite
+					for (size_t i = std::max(newSz, digitsBegin); i < max_sz; i++)
+					{
+						container[i] = terminator_value;
 					}
 				}
 			}
-			else // throw
+
+			terminator = static_cast<data_t>(static_cast<length_t>(count));
+		}
+
+		template <typename iterator_t>
+		constexpr void assign(iterator_t it, iterator_t end)
+		{
+			clear();
+			append_range(it, end);
+		}
+
+		template <typename iterator_t>
+		constexpr void append_range(iterator_t it, iterator_t end)
+		{
+			// size and distance are both clamped where the optimizer can see it, otherwise it can't bound the
+			// writes below to the container (size() is decoded from the buffer) and warns about overflows
+			const size_t sz = std::min(size(), max_sz);
+			auto distance = static_cast<size_t>(std::distance(it, end));
+
+			if constexpr (throw_on_overrun)
 			{
-				if (distance > max_sz)
+				if (distance > max_sz - sz)
 				{
 					throw std::runtime_error("string too small for contents, aborting assignment");
 				}
-				else
+			}
+			distance = std::min(distance, max_sz - sz);
+
+			constexpr bool contiguous_source = std::is_pointer_v<iterator_t>
+				&& std::is_same_v<std::remove_cv_t<std::remove_pointer_t<iterator_t>>, data_t>;
+			if constexpr (contiguous_source && std::is_same_v<transform, lower_case>)
+			{	// case transforms are done in blocks rather than a char at a time
+				cxpr::lower_case_copy(data() + sz, it, distance);
+			}
+			else if constexpr (contiguous_source && std::is_same_v<transform, upper_case>)
+			{
+				cxpr::upper_case_copy(data() + sz, it, distance);
+			}
+			else
+			{
+				auto containerOut = begin() + sz;
+				for (size_t i = 0; i < distance; i++)
+				{
+					*containerOut++ = transform{}(static_cast<data_t>(*it++));
+				}
+			}
+
+			set_size(sz + distance);
+		}
+
+		my_t& append_chars(const char* first, std::to_chars_result res)
+		{
+			if (res.ec != std::errc{})
+			{	// the scratch buffer is larger than our capacity and the contents are unspecified on failure,
+				// so there is nothing sensible to truncate
+				if constexpr (throw_on_overrun)
 				{
-					std::transform(it, end, std::begin(container), transform());
+					throw std::runtime_error("string too small for contents, aborting assignment");
 				}
+				return *this;
 			}
+
+			append_range(first, static_cast<const char*>(res.ptr));
+			return *this;
 		}
 	};
 
@@ -375,6 +606,68 @@ namespace cxpr
 		typename overrun_behavior = overrun_behavior_trunc>
 		using wfixed_string = basic_fixed_string<wchar_t, max_sz, transform, overrun_behavior>;
 
+	//////////////////////////////////////////////////////////////////////////
+	// Opt-in fixed_string wrapper that computes hash_invariant once per assignment and caches it.
+	// Equality checks the cached hashes first, so most mismatches never touch the characters. Only const
+	// access to the string is exposed so the cached value can't go stale
+	template <size_t max_sz,
+		typename transform = no_transform,
+		typename overrun_behavior = overrun_behavior_trunc>
+		class hashed_fixed_string
+	{
+	public:
+		using string_t = fixed_string<max_sz, transform, overrun_behavior>;
+		using my_t = hashed_fixed_string<max_sz, transform, overrun_behavior>;
+		using const_iterator = typename string_t::const_iterator;
+
+		constexpr hashed_fixed_string() noexcept : value{}, cached{ hash_invariant(value) } {}
+		constexpr hashed_fixed_string(const string_t& in) noexcept : value(in), cached{ hash_invariant(value) } {}
+		constexpr hashed_fixed_string(const std::string_view in) noexcept : value(in), cached{ hash_invariant(value) } {}
+
+		constexpr my_t& operator=(const string_t& in) noexcept
+		{
+			value = in;
+			cached = hash_invariant(value);
+			return *this;
+		}
+
+		constexpr my_t& operator=(const std::string_view in) noexcept
+		{
+			value = string_t(in);
+			cached = hash_invariant(value);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr cxpr::hash_t hash_code() const noexcept { return cached; }
+		[[nodiscard]] constexpr cxpr::hash_t hash()		 const noexcept { return cached; }
+		[[nodiscard]] constexpr const string_t& str()	 const noexcept { return value; }
+
+		constexpr const char* c_str() const noexcept { return value.c_str(); }
+		constexpr const char* data()  const noexcept { return value.data(); }
+		constexpr size_t size()		  const noexcept { return value.size(); }
+		constexpr size_t capacity()	  const noexcept { return value.capacity(); }
+		constexpr const_iterator begin() const noexcept { return value.begin(); }
+		constexpr const_iterator end()	 const noexcept { return value.end(); }
+
+		constexpr operator std::string_view() const { return value; }
+
+		[[nodiscard]] constexpr bool operator==(const my_t& other) const noexcept
+		{
+			return cached == other.cached && value == other.value;
+		}
+
+		[[nodiscard]] constexpr bool operator!=(const my_t& other) const noexcept { return !(*this == other); }
+		[[nodiscard]] constexpr bool operator<(const my_t& other)  const noexcept { return value < other.value; }
+
+		// hashing the other side would cost more than just comparing, so this skips the cache
+		[[nodiscard]] constexpr bool operator==(const std::string_view other) const noexcept { return value == other; }
+		[[nodiscard]] constexpr bool operator!=(const std::string_view other) const noexcept { return value != other; }
+
+	private:
+		string_t value;
+		cxpr::hash_t cached;
+	};
+
 	//////////////////////////////////////////////////////////////////////////
 	// Below make an fixed string large enough to contain the passed value, rounds to closest power of 2
 	// ie: a 24 byte string will return a 32 bit fixed_string
@@ -390,6 +683,16 @@ namespace cxpr
 		return basic_fixed_string<wchar_t, cxpr::round_pow_2_v<n>, transform_t>(in);
 	}
 
+	//////////////////////////////////////////////////////////////////////////
+	// Appends each param to the passed fixed string in order, see basic_fixed_string::append for supported types
+	//	 cxpr::format_to(label, "shard_", shardIdx, "_latency=", latencyMs);
+	template <typename string_t, typename ... params_t>
+	constexpr string_t& format_to(string_t& out, const params_t& ... params)
+	{
+		(out.append(params), ...);
+		return out;
+	}
+
 	//////////////////////////////////////////////////////////////////////////
 
 	constexpr decltype(auto) operator"" _fixed32(const char* n, size_t sz)
@@ -404,7 +707,7 @@ namespace cxpr
 
 	constexpr cxpr::hash_t operator"" _hash(const char* n, size_t sz)
 	{
-		return hash_invariant(n);
+		return hash_invariant(std::string_view(n, sz));
 	}
 
 	//////////////////////////////////////////////////////////////////////////
@@ -429,7 +732,7 @@ namespace cxpr
 	template <typename ... T>
 	std::ostream& operator<<(std::ostream& os, const basic_fixed_string<T...>& str)
 	{
-		os << "test"
+		os << "test";
 		return os;
 	}
 }
@@ -68,6 +68,21 @@ namespace cxpr
 			throw std::out_of_range("static_vector::emplace_back out of range");
 		}
 
+		constexpr void pop_back()
+		{
+			if (currentSz == 0)
+			{
+				throw std::out_of_range("static_vector::pop_back on empty vector");
+			}
+
+			currentSz--;
+			if constexpr (std::is_trivially_destructible_v<T> == false)
+			{
+				mem[currentSz].~T();
+				new(&mem[currentSz]) T();
+			}
+		}
+
 		constexpr const_reference operator[](size_t idx) const  { return mem[idx]; }
 		constexpr reference		  operator[](size_t idx)		{ return mem[idx]; }
 
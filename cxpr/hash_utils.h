@@ -0,0 +1,155 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		//////////////////////////////////////////////////////////////////////////
+		// C++17 stand-in for std::is_constant_evaluated. If the compiler can't tell us, assume we're
+		// at compile-time so only the constexpr-safe paths are used
+		constexpr bool is_constant_evaluated() noexcept
+		{
+#if defined(__cpp_lib_is_constant_evaluated)
+			return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+			return __builtin_is_constant_evaluated();
+#else
+			return true;
+#endif
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// 64x64 -> 128 bit multiply, folded back down to 64 bits by xor-ing the halves
+		constexpr uint64_t mum_mix(uint64_t a, uint64_t b) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			const __uint128_t r = static_cast<__uint128_t>(a) * b;
+			return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+			// portable (and constexpr-friendly) schoolbook version for compilers without 128 bit ints
+			const uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+			const uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+			const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+			const uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+			const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFull) + lo_hi;
+			const uint64_t lo = (cross << 32) | (lo_lo & 0xFFFFFFFFull);
+			const uint64_t hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+			return lo ^ hi;
+#endif
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// Lowercases every ASCII 'A'-'Z' byte in the word at once, everything else is left untouched
+		constexpr uint64_t fold_case_swar(uint64_t word) noexcept
+		{
+			constexpr uint64_t ones = 0x0101010101010101ull;
+			const uint64_t heptets = word & (0x7F * ones);
+			const uint64_t above_Z = heptets + ((0x7F - 'Z') * ones);
+			const uint64_t from_A  = heptets + ((0x80 - 'A') * ones);
+			const uint64_t is_upper = ~word & (from_A ^ above_Z) & (0x80 * ones);
+			return word | (is_upper >> 2);
+		}
+
+		// little-endian reads, spelled out byte by byte so they're usable at compile-time. Not every
+		// optimizer collapses the loop, so at run time little-endian targets use a plain load
+		template <bool fold_case>
+		constexpr uint64_t hash_read(const char* p, size_t count) noexcept
+		{
+			uint64_t word = 0;
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			if (is_constant_evaluated() == false)
+			{
+				std::memcpy(&word, p, count);
+			}
+			else
+#endif
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					word |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (i * 8);
+				}
+			}
+
+			if constexpr (fold_case)
+			{
+				word = fold_case_swar(word);
+			}
+			return word;
+		}
+
+		template <bool fold_case>
+		constexpr uint64_t hash_read_small(const char* p, size_t count) noexcept
+		{	// 1-3 bytes, reads the first, middle, and last byte
+			const uint64_t word = (static_cast<uint64_t>(static_cast<unsigned char>(p[0])) << 16)
+				| (static_cast<uint64_t>(static_cast<unsigned char>(p[count >> 1])) << 8)
+				| static_cast<uint64_t>(static_cast<unsigned char>(p[count - 1]));
+
+			if constexpr (fold_case)
+			{
+				return fold_case_swar(word);
+			}
+			return word;
+		}
+
+		static constexpr uint64_t hash_secret[4] = {
+			0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+		//////////////////////////////////////////////////////////////////////////
+		// wyhash-style hash (https://github.com/wangyi-fudan/wyhash) over a byte range. Consumes 8 bytes per read
+		// and 48 bytes per round in three independent lanes. Identical results at compile and run time.
+		// If fold_case is set ASCII letters are lowercased as they're read, making the hash case-invariant
+		template <bool fold_case>
+		constexpr uint64_t hash_bytes(const char* p, size_t len, uint64_t seed = 0) noexcept
+		{
+			seed ^= mum_mix(seed ^ hash_secret[0], hash_secret[1]);
+
+			uint64_t a = 0;
+			uint64_t b = 0;
+			if (len <= 16)
+			{
+				if (len >= 4)
+				{
+					const size_t mid = (len >> 3) << 2;
+					a = (hash_read<fold_case>(p, 4) << 32) | hash_read<fold_case>(p + mid, 4);
+					b = (hash_read<fold_case>(p + len - 4, 4) << 32) | hash_read<fold_case>(p + len - 4 - mid, 4);
+				}
+				else if (len > 0)
+				{
+					a = hash_read_small<fold_case>(p, len);
+				}
+			}
+			else
+			{
+				size_t i = len;
+				if (i > 48)
+				{
+					uint64_t see1 = seed;
+					uint64_t see2 = seed;
+					do
+					{
+						seed = mum_mix(hash_read<fold_case>(p, 8) ^ hash_secret[1], hash_read<fold_case>(p + 8, 8) ^ seed);
+						see1 = mum_mix(hash_read<fold_case>(p + 16, 8) ^ hash_secret[2], hash_read<fold_case>(p + 24, 8) ^ see1);
+						see2 = mum_mix(hash_read<fold_case>(p + 32, 8) ^ hash_secret[3], hash_read<fold_case>(p + 40, 8) ^ see2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= see1 ^ see2;
+				}
+
+				while (i > 16)
+				{
+					seed = mum_mix(hash_read<fold_case>(p, 8) ^ hash_secret[1], hash_read<fold_case>(p + 8, 8) ^ seed);
+					i -= 16;
+					p += 16;
+				}
+
+				a = hash_read<fold_case>(p + i - 16, 8);
+				b = hash_read<fold_case>(p + i - 8, 8);
+			}
+
+			return mum_mix(hash_secret[1] ^ len, mum_mix(a ^ hash_secret[1], b ^ seed));
+		}
+	}
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	//////////////////////////////////////////////////////////////////////////
+	// std::function replacement that never allocates: the callable is stored in 'capacity' bytes of inline
+	// storage, and one that doesn't fit is a compile error instead of a heap fallback. The call goes through a
+	// single function pointer held in the object itself, and trivially copyable callables (function pointers,
+	// lambdas capturing pointers or integers) are copied and moved with a memcpy.
+	//	 cxpr::fixed_vector<cxpr::inplace_function<void(const request&)>, 8> on_request;
+	//	 on_request.push_back([&stats](const request& r) { stats.count(r); });
+	// The default constructor is constexpr, so static containers of empty functions are constant initialized.
+	// It isn't a literal type though (the destructor runs the stored callable's), so it can't be a constexpr
+	// value, e.g. inside a constexpr static_map; build those at run time.
+	// Calling an empty function throws std::bad_function_call, moving from a function leaves it empty
+	template <typename sig_t, size_t capacity = 4 * sizeof(void*), size_t align = alignof(std::max_align_t)>
+	class inplace_function;
+
+	template <typename R, typename ... args_t, size_t capacity, size_t align>
+	class inplace_function<R(args_t...), capacity, align>
+	{
+	public:
+		using my_t = inplace_function<R(args_t...), capacity, align>;
+		using result_type = R;
+
+		template <typename fun_t>
+		static constexpr bool fits_v = sizeof(fun_t) <= capacity && align % alignof(fun_t) == 0;
+
+		constexpr inplace_function() noexcept {}
+		constexpr inplace_function(std::nullptr_t) noexcept {}
+
+		template <typename fun_t, typename = std::enable_if_t<!std::is_same_v<std::decay_t<fun_t>, my_t>
+			&& std::is_invocable_r_v<R, std::decay_t<fun_t>&, args_t...>>>
+		inplace_function(fun_t&& fun)
+		{
+			using stored_t = std::decay_t<fun_t>;
+			static_assert(sizeof(stored_t) <= capacity, "callable is too large for this inplace_function, increase the capacity");
+			static_assert(align % alignof(stored_t) == 0, "callable needs more alignment than this inplace_function provides");
+			static_assert(std::is_copy_constructible_v<stored_t>, "inplace_function callables must be copy constructible");
+			static_assert(std::is_nothrow_move_constructible_v<stored_t>, "inplace_function callables must be nothrow movable");
+
+			if constexpr (std::is_pointer_v<stored_t> || std::is_member_pointer_v<stored_t>)
+			{
+				if (fun == nullptr)
+				{
+					return;
+				}
+			}
+
+			new (storage) stored_t(std::forward<fun_t>(fun));
+			invoker = &invoke_stored<stored_t>;
+			ops = &__detail::any_vtable_for<stored_t>::value;
+		}
+
+		inplace_function(const my_t& other)
+		{
+			copy_from(other);
+		}
+
+		inplace_function(my_t&& other) noexcept
+		{
+			take(other);
+		}
+
+		~inplace_function() { reset(); }
+
+		my_t& operator=(const my_t& other)
+		{
+			if (this != &other)
+			{
+				my_t copy(other); // a throwing copy leaves us untouched
+				reset();
+				take(copy);
+			}
+			return *this;
+		}
+
+		my_t& operator=(my_t&& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+				take(other);
+			}
+			return *this;
+		}
+
+		my_t& operator=(std::nullptr_t) noexcept
+		{
+			reset();
+			return *this;
+		}
+
+		template <typename fun_t, typename = std::enable_if_t<!std::is_same_v<std::decay_t<fun_t>, my_t>
+			&& std::is_invocable_r_v<R, std::decay_t<fun_t>&, args_t...>>>
+		my_t& operator=(fun_t&& fun)
+		{
+			return *this = my_t(std::forward<fun_t>(fun));
+		}
+
+		R operator()(args_t... args) const
+		{
+			return invoker(const_cast<unsigned char*>(storage), std::forward<args_t>(args)...);
+		}
+
+		void reset() noexcept
+		{
+			if (ops != nullptr)
+			{
+				ops->destroy(storage);
+				ops = nullptr;
+				invoker = &invoke_empty;
+			}
+		}
+
+		[[nodiscard]] constexpr explicit operator bool() const noexcept { return ops != nullptr; }
+
+		// typehash_v of the stored callable, 0 when empty. Only a hint, different types can share a hash (see typehash_v)
+		[[nodiscard]] constexpr cxpr::hash_t target_type() const noexcept { return ops != nullptr ? ops->type : 0; }
+
+		// Pointer to the stored callable if it's a fun_t, nullptr otherwise
+		template <typename fun_t>
+		[[nodiscard]] fun_t* target() noexcept
+		{
+			return ops == &__detail::any_vtable_for<fun_t>::value ? std::launder(reinterpret_cast<fun_t*>(storage)) : nullptr;
+		}
+
+		template <typename fun_t>
+		[[nodiscard]] const fun_t* target() const noexcept
+		{
+			return ops == &__detail::any_vtable_for<fun_t>::value ? std::launder(reinterpret_cast<const fun_t*>(storage)) : nullptr;
+		}
+
+	private:
+		using invoker_t = R(*)(void* obj, args_t&& ... args);
+
+		invoker_t invoker = &invoke_empty;
+		const __detail::any_vtable* ops = nullptr;
+		union
+		{
+			char unused = 0; // lets the default constructor be constexpr without clearing the storage
+			alignas(align) unsigned char storage[capacity];
+		};
+
+		static R invoke_empty(void*, args_t&& ...)
+		{
+			throw std::bad_function_call();
+		}
+
+		template <typename fun_t>
+		static R invoke_stored(void* obj, args_t&& ... args)
+		{
+			return std::invoke(*std::launder(static_cast<fun_t*>(obj)), std::forward<args_t>(args)...);
+		}
+
+		void copy_from(const my_t& other)
+		{
+			if (other.ops == nullptr)
+			{
+				return;
+			}
+
+			if (other.ops->trivial)
+			{
+				std::memcpy(storage, other.storage, capacity);
+			}
+			else
+			{
+				other.ops->copy(storage, other.storage);
+			}
+			invoker = other.invoker;
+			ops = other.ops;
+		}
+
+		void take(my_t& other) noexcept
+		{
+			if (other.ops == nullptr)
+			{
+				return;
+			}
+
+			if (other.ops->trivial)
+			{
+				std::memcpy(storage, other.storage, capacity);
+			}
+			else
+			{
+				other.ops->move(storage, other.storage);
+			}
+			invoker = other.invoker;
+			ops = other.ops;
+			other.invoker = &invoke_empty;
+			other.ops = nullptr;
+		}
+	};
+}
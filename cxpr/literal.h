@@ -0,0 +1,150 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	template <char ... chars>
+	struct literal;
+
+	namespace __detail
+	{
+		template <typename literal_t, size_t offset, size_t ... idx>
+		constexpr decltype(auto) literal_slice(std::index_sequence<idx...>) noexcept
+		{
+			return literal<literal_t::value[offset + idx]...>{};
+		}
+
+		template <typename provider_t, size_t ... idx>
+		constexpr decltype(auto) literal_from(std::index_sequence<idx...>) noexcept
+		{
+			return literal<provider_t::value()[idx]...>{};
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// A string whose contents are the type itself, so every operation below happens during compile and
+	// the results can drive template specialization/if constexpr. Objects are empty tags, create them with
+	// CXPR_LITERAL("...") (or cxpr::lit<"..."> in C++20) and use decltype() to get at the type
+	//
+	//	 constexpr auto host = CXPR_LITERAL("Host");
+	//	 using lower_t = decltype(host)::lower_t;						  // literal<'h','o','s','t'>
+	//	 constexpr auto entry = map.get_entry<decltype(host)::hash>();	  // folds to a constant
+	template <char ... chars>
+	struct literal
+	{
+		using my_t = literal<chars...>;
+		static constexpr size_t npos = std::string_view::npos;
+
+		static constexpr char value[] = { chars..., '\0' };
+		static constexpr cxpr::hash_t hash = hash_invariant(std::string_view(value, sizeof...(chars)));
+
+		using lower_t = literal<cx_tolower(chars)...>;
+		using upper_t = literal<cx_toupper(chars)...>;
+
+		// literal holding [pos, pos + count), count is clamped to the end like std::string_view::substr
+		template <size_t pos, size_t count = npos>
+		using substr_t = decltype(__detail::literal_slice<my_t, pos>(
+			std::make_index_sequence<std::min(count, sizeof...(chars) - std::min(pos, sizeof...(chars)))>{}));
+
+		static constexpr size_t size()			  noexcept { return sizeof...(chars); }
+		static constexpr bool empty()			  noexcept { return sizeof...(chars) == 0; }
+		static constexpr const char* c_str()	  noexcept { return value; }
+		static constexpr std::string_view view()  noexcept { return std::string_view(value, sizeof...(chars)); }
+		constexpr operator std::string_view() const noexcept { return view(); }
+
+		static constexpr size_t find(char ch, size_t pos = 0) noexcept { return view().find(ch, pos); }
+		static constexpr size_t find(std::string_view needle, size_t pos = 0) noexcept { return view().find(needle, pos); }
+
+		static constexpr bool starts_with(std::string_view prefix) noexcept
+		{
+			return prefix.size() <= size() && view().substr(0, prefix.size()) == prefix;
+		}
+
+		static constexpr bool ends_with(std::string_view suffix) noexcept
+		{
+			return suffix.size() <= size() && view().substr(size() - suffix.size()) == suffix;
+		}
+
+		// fixed_string just large enough to hold the literal (rounded up to a power of 2)
+		static constexpr decltype(auto) to_fixed_string() noexcept
+		{
+			return fixed_string<cxpr::round_pow_2_v<sizeof...(chars) + 1>>(view());
+		}
+	};
+
+	template <typename T>
+	struct is_literal : std::false_type {};
+
+	template <char ... chars>
+	struct is_literal<literal<chars...>> : std::true_type {};
+
+	template <typename T>
+	static constexpr bool is_literal_v = is_literal<std::decay_t<T>>::value;
+
+	//////////////////////////////////////////////////////////////////////////
+
+	template <char ... l, char ... r>
+	constexpr literal<l..., r...> operator+(literal<l...>, literal<r...>) noexcept { return {}; }
+
+	template <char ... l, char ... r>
+	constexpr bool operator==(literal<l...>, literal<r...>) noexcept
+	{
+		return std::is_same_v<literal<l...>, literal<r...>>;
+	}
+
+	template <char ... l, char ... r>
+	constexpr bool operator!=(literal<l...> lhs, literal<r...> rhs) noexcept { return !(lhs == rhs); }
+
+	template <size_t pos, size_t count = std::string_view::npos, char ... chars>
+	constexpr decltype(auto) substr(literal<chars...>) noexcept
+	{
+		static_assert(pos <= sizeof...(chars), "substr position is past the end of the literal");
+		return typename literal<chars...>::template substr_t<pos, count>{};
+	}
+
+	template <char ... chars>
+	constexpr decltype(auto) to_lower(literal<chars...>) noexcept { return typename literal<chars...>::lower_t{}; }
+
+	template <char ... chars>
+	constexpr decltype(auto) to_upper(literal<chars...>) noexcept { return typename literal<chars...>::upper_t{}; }
+
+	//////////////////////////////////////////////////////////////////////////
+	// C++20 class-type NTTP path: cxpr::lit<"text"> names the literal type directly
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+	template <size_t n>
+	struct literal_chars
+	{
+		char data[n] = {};
+
+		constexpr literal_chars(const char(&in)[n]) noexcept
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				data[i] = in[i];
+			}
+		}
+	};
+
+	namespace __detail
+	{
+		template <literal_chars str, size_t ... idx>
+		constexpr decltype(auto) literal_from_chars(std::index_sequence<idx...>) noexcept
+		{
+			return literal<str.data[idx]...>{};
+		}
+	}
+
+	template <literal_chars str>
+	using lit = decltype(__detail::literal_from_chars<str>(std::make_index_sequence<sizeof(str.data) - 1>{}));
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////
+// C++17 way of turning a string literal into a cxpr::literal object, the local provider struct carries the
+// literal into a template param so it can be expanded one char at a time
+#define CXPR_LITERAL(str) []() constexpr {													\
+		struct literal_provider { static constexpr std::string_view value() { return str; } };	\
+		return ::cxpr::__detail::literal_from<literal_provider>(								\
+			std::make_index_sequence<literal_provider::value().size()>{});						\
+	}()
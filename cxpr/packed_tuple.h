@@ -0,0 +1,186 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		// Stored position of each logical member
+		template <size_t n>
+		constexpr std::array<size_t, n> packed_slots(const std::array<size_t, n>& order) noexcept
+		{
+			std::array<size_t, n> slots{};
+			for (size_t i = 0; i < n; i++)
+			{
+				slots[order[i]] = i;
+			}
+			return slots;
+		}
+
+		// One base per stored member, the slot keeps repeated types distinct
+		template <size_t slot, typename T>
+		struct packed_leaf
+		{
+			constexpr packed_leaf() : value() {}
+
+			template <typename arg_t>
+			constexpr packed_leaf(std::true_type, arg_t&& arg) : value(std::forward<arg_t>(arg)) {}
+
+			T value;
+		};
+
+		template <typename order_t, typename ... types_t>
+		struct packed_storage;
+
+		template <size_t ... slot, typename ... types_t>
+		struct packed_storage<std::index_sequence<slot...>, types_t...> : packed_leaf<slot, types_t>...
+		{
+			constexpr packed_storage() = default;
+
+			template <typename args_t>
+			constexpr packed_storage(std::true_type tag, args_t&& args)
+				: packed_leaf<slot, types_t>(tag, std::get<slot>(std::move(args)))... {}
+		};
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Tuple that stores its members sorted by descending alignment, while get<I> keeps the logical order
+	// they were declared in. Only the end of the tuple can be padded:
+	//	 cxpr::packed_tuple<char, double, char, int> rec('a', 1.5, 'b', 7);	// 16 bytes, std::tuple: 24
+	//	 auto [side, price, flag, qty] = rec;
+	// 'report' compares the layout with std::tuple during compile:
+	//	 static_assert(cxpr::packed_tuple<char, double, char, int>::report.saved_bytes == 8);
+	template <typename ... types_t>
+	class packed_tuple
+	{
+		// Logical index of each stored member, by descending alignment so no member needs padding before it
+		static constexpr std::array<size_t, sizeof...(types_t)> order =
+			__detail::stable_order_desc(std::array<size_t, sizeof...(types_t)>{ alignof(types_t)... });
+		static constexpr std::array<size_t, sizeof...(types_t)> slots = __detail::packed_slots(order);
+
+		template <template <typename ...> class wrapper_t, size_t ... slot>
+		static auto stored(std::index_sequence<slot...>) -> wrapper_t<std::tuple_element_t<order[slot], std::tuple<types_t...>>...>;
+
+		template <typename ... stored_t>
+		using storage_for = __detail::packed_storage<std::index_sequence_for<stored_t...>, stored_t...>;
+
+		using storage_t = decltype(stored<storage_for>(std::index_sequence_for<types_t...>{}));
+
+		// Constructor args rearranged into stored order
+		template <typename args_t, size_t ... slot>
+		static constexpr decltype(auto) stored_args(args_t&& args, std::index_sequence<slot...>)
+		{
+			return std::forward_as_tuple(std::get<order[slot]>(std::move(args))...);
+		}
+
+	public:
+		using my_t = packed_tuple<types_t...>;
+
+		template <size_t idx>
+		using element_t = std::tuple_element_t<idx, std::tuple<types_t...>>;
+
+		// Member types in the order they are stored
+		using stored_types = decltype(stored<typeset>(std::index_sequence_for<types_t...>{}));
+
+		struct layout_report
+		{
+			size_t packed_bytes;	// sizeof(packed_tuple)
+			size_t tuple_bytes;		// sizeof(std::tuple) of the same types
+			size_t saved_bytes;
+			size_t padding_bytes;	// left in the packed_tuple, only ever at the end
+		};
+
+		constexpr packed_tuple() = default;
+
+		template <typename ... args_t, typename = std::enable_if_t<sizeof...(args_t) == sizeof...(types_t) && sizeof...(args_t) != 0
+			&& !(std::is_same_v<std::decay_t<args_t>, my_t> && ...) && (std::is_constructible_v<types_t, args_t&&> && ...)>>
+		constexpr packed_tuple(args_t&& ... args)
+			: storage(std::true_type{}, stored_args(std::forward_as_tuple(std::forward<args_t>(args)...), std::index_sequence_for<types_t...>{})) {}
+
+		// Logical index idx, wherever it is stored
+		template <size_t idx>
+		constexpr element_t<idx>& get() & noexcept
+		{
+			return static_cast<__detail::packed_leaf<slots[idx], element_t<idx>>&>(storage).value;
+		}
+
+		template <size_t idx>
+		constexpr const element_t<idx>& get() const & noexcept
+		{
+			return static_cast<const __detail::packed_leaf<slots[idx], element_t<idx>>&>(storage).value;
+		}
+
+		template <size_t idx>
+		constexpr element_t<idx>&& get() && noexcept
+		{
+			return std::move(static_cast<__detail::packed_leaf<slots[idx], element_t<idx>>&>(storage).value);
+		}
+
+		// Copy in logical order
+		constexpr std::tuple<types_t...> to_tuple() const
+		{
+			return to_tuple(std::index_sequence_for<types_t...>{});
+		}
+
+		constexpr bool operator==(const my_t& other) const
+		{
+			return equal(other, std::index_sequence_for<types_t...>{});
+		}
+
+		constexpr bool operator!=(const my_t& other) const
+		{
+			return !(*this == other);
+		}
+
+		static constexpr layout_report report = {
+			sizeof(storage_t),
+			sizeof(std::tuple<types_t...>),
+			sizeof(std::tuple<types_t...>) > sizeof(storage_t) ? sizeof(std::tuple<types_t...>) - sizeof(storage_t) : 0,
+			sizeof(storage_t) - ((std::is_empty_v<types_t> ? 0 : sizeof(types_t)) + ... + 0),
+		};
+
+	private:
+		storage_t storage;
+
+		template <size_t ... idx>
+		constexpr std::tuple<types_t...> to_tuple(std::index_sequence<idx...>) const
+		{
+			return { get<idx>()... };
+		}
+
+		template <size_t ... idx>
+		constexpr bool equal(const my_t& other, std::index_sequence<idx...>) const
+		{
+			return ((get<idx>() == other.template get<idx>()) && ...);
+		}
+	};
+
+	// Free get<I>, used by structured bindings
+	template <size_t idx, typename ... types_t>
+	constexpr decltype(auto) get(packed_tuple<types_t...>& tt) noexcept
+	{
+		return tt.template get<idx>();
+	}
+
+	template <size_t idx, typename ... types_t>
+	constexpr decltype(auto) get(const packed_tuple<types_t...>& tt) noexcept
+	{
+		return tt.template get<idx>();
+	}
+
+	template <size_t idx, typename ... types_t>
+	constexpr decltype(auto) get(packed_tuple<types_t...>&& tt) noexcept
+	{
+		return std::move(tt).template get<idx>();
+	}
+}
+
+namespace std
+{
+	template <typename ... types_t>
+	struct tuple_size<cxpr::packed_tuple<types_t...>> : std::integral_constant<size_t, sizeof...(types_t)> {};
+
+	template <size_t idx, typename ... types_t>
+	struct tuple_element<idx, cxpr::packed_tuple<types_t...>> : std::tuple_element<idx, std::tuple<types_t...>> {};
+}
@@ -0,0 +1,670 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+// Locale-independent number parsing that works on any string_view (no null terminator needed) and gives
+// bit-identical results at compile and run time. The whole input has to be the number, errors are reported
+// through std::errc like std::from_chars:
+//	 invalid_argument	 - empty, stray characters, or a sign on an unsigned type
+//	 result_out_of_range - the value doesn't fit the type (for floats: overflows to inf or underflows to 0)
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		constexpr bool is_digit(char ch) noexcept
+		{
+			return ch >= '0' && ch <= '9';
+		}
+
+		// true if all 8 bytes of the little-endian word are '0'-'9'
+		constexpr bool is_eight_digits(uint64_t word) noexcept
+		{
+			return ((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+				== 0x3333333333333333ull;
+		}
+
+		// Converts 8 ASCII digits to their value with three multiplies, pairing up digits at each step
+		constexpr uint32_t parse_eight_digits(uint64_t word) noexcept
+		{
+			constexpr uint64_t mask = 0x000000FF000000FFull;
+			constexpr uint64_t mul1 = 100 + (1000000ull << 32);
+			constexpr uint64_t mul2 = 1 + (10000ull << 32);
+			word -= 0x3030303030303030ull;
+			word = (word * 10) + (word >> 8);
+			word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+			return static_cast<uint32_t>(word);
+		}
+
+		// Largest value that can take another 8 digits without wrapping
+		static constexpr uint64_t eight_digit_limit = (std::numeric_limits<uint64_t>::max() - 99999999ull) / 100000000ull;
+
+		// Reads the digits in [p, end) into value, returns errc::result_out_of_range if they don't fit in 64 bits
+		constexpr std::errc parse_digits(const char* p, const char* end, uint64_t& value) noexcept
+		{
+			uint64_t result = 0;
+			while (end - p >= 8 && result <= eight_digit_limit)
+			{
+				const uint64_t word = hash_read<false>(p, 8);
+				if (is_eight_digits(word) == false)
+				{
+					break;
+				}
+				result = result * 100000000ull + parse_eight_digits(word);
+				p += 8;
+			}
+
+			for (; p != end; p++)
+			{
+				if (is_digit(*p) == false)
+				{
+					return std::errc::invalid_argument;
+				}
+
+				const uint64_t digit = static_cast<uint64_t>(*p - '0');
+				if (result > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+				{
+					for (p++; p != end; p++)
+					{	// keep going so junk still reports as invalid
+						if (is_digit(*p) == false)
+						{
+							return std::errc::invalid_argument;
+						}
+					}
+					return std::errc::result_out_of_range;
+				}
+				result = result * 10 + digit;
+			}
+
+			value = result;
+			return std::errc{};
+		}
+
+		template <typename int_t>
+		constexpr std::errc parse_integer(std::string_view in, int_t& out) noexcept
+		{
+			const char* p = in.data();
+			const char* end = p + in.size();
+
+			bool negative = false;
+			if constexpr (std::is_signed_v<int_t>)
+			{
+				if (p != end && *p == '-')
+				{
+					negative = true;
+					p++;
+				}
+			}
+
+			if (p == end)
+			{
+				return std::errc::invalid_argument;
+			}
+
+			uint64_t magnitude = 0;
+			const auto ec = parse_digits(p, end, magnitude);
+			if (ec != std::errc{})
+			{
+				return ec;
+			}
+
+			using uint_t = std::make_unsigned_t<int_t>;
+			const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int_t>::max()) + (negative ? 1 : 0);
+			if (magnitude > limit)
+			{
+				return std::errc::result_out_of_range;
+			}
+
+			out = negative ? static_cast<int_t>(uint_t(0) - static_cast<uint_t>(magnitude)) : static_cast<int_t>(magnitude);
+			return std::errc{};
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// floats
+
+		template <typename float_t>
+		struct float_info;
+
+		template <>
+		struct float_info<double>
+		{
+			static constexpr int mantissa_bits = 52;
+			static constexpr int exponent_bits = 11;
+			static constexpr int bias = -1023;
+			static constexpr uint64_t max_exact = 1ull << 53;
+			static constexpr int max_exact_pow10 = 22;
+			static constexpr double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		};
+
+		template <>
+		struct float_info<float>
+		{
+			static constexpr int mantissa_bits = 23;
+			static constexpr int exponent_bits = 8;
+			static constexpr int bias = -127;
+			static constexpr uint64_t max_exact = 1ull << 24;
+			static constexpr int max_exact_pow10 = 10;
+			static constexpr float pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+		};
+
+		// What the scanner pulls out of the text: up to 19 significant digits and a base 10 exponent
+		struct decimal_parts
+		{
+			uint64_t mantissa = 0;
+			int64_t exponent = 0;
+			bool negative = false;
+			bool truncated = false;	// nonzero digits past the 19 kept in mantissa
+		};
+
+		// Big-endian decimal digits with the decimal point at 'point'. Only used when the fast path can't give
+		// an exact answer and there is no std::from_chars to lean on (ie during compile). Digit shifting in
+		// the style of Go's strconv: correctly rounded, just not fast
+		struct big_decimal
+		{
+			static constexpr int max_digits = 800;
+			static constexpr int max_shift = 60;
+
+			uint8_t digits[max_digits + 24] = {};
+			int count = 0;
+			int point = 0;
+			bool truncated = false;
+
+			constexpr void trim() noexcept
+			{
+				while (count > 0 && digits[count - 1] == 0)
+				{
+					count--;
+				}
+				if (count == 0)
+				{
+					point = 0;
+				}
+			}
+
+			constexpr void shift_right(int k) noexcept
+			{
+				int r = 0;
+				int w = 0;
+				uint64_t n = 0;
+				for (; (n >> k) == 0; r++)
+				{
+					if (r >= count)
+					{
+						if (n == 0)
+						{
+							count = 0;
+							return;
+						}
+						while ((n >> k) == 0)
+						{
+							n = n * 10;
+							r++;
+						}
+						break;
+					}
+					n = n * 10 + digits[r];
+				}
+				point -= r - 1;
+
+				const uint64_t mask = (1ull << k) - 1;
+				for (; r < count; r++)
+				{
+					const uint64_t digit = n >> k;
+					n &= mask;
+					digits[w++] = static_cast<uint8_t>(digit);
+					n = n * 10 + digits[r];
+				}
+				while (n > 0)
+				{
+					const uint64_t digit = n >> k;
+					n &= mask;
+					if (w < max_digits)
+					{
+						digits[w++] = static_cast<uint8_t>(digit);
+					}
+					else if (digit > 0)
+					{
+						truncated = true;
+					}
+					n = n * 10;
+				}
+				count = w;
+				trim();
+			}
+
+			constexpr void shift_left(int k) noexcept
+			{	// 2^k has at most floor(k * log10(2)) + 1 digits, so the result is written that far to the right
+				// and moved back down once the real number of new digits is known
+				const int spare = ((k * 1233) >> 12) + 1;
+				int w = count + spare;
+				uint64_t n = 0;
+				for (int r = count - 1; r >= 0; r--)
+				{
+					n += static_cast<uint64_t>(digits[r]) << k;
+					const uint64_t quo = n / 10;
+					digits[--w] = static_cast<uint8_t>(n - 10 * quo);
+					n = quo;
+				}
+				while (n > 0)
+				{
+					const uint64_t quo = n / 10;
+					digits[--w] = static_cast<uint8_t>(n - 10 * quo);
+					n = quo;
+				}
+
+				const int added = spare - w;
+				int newCount = count + added;
+				for (int i = 0; i < newCount; i++)
+				{
+					digits[i] = digits[i + w];
+				}
+				for (int i = max_digits; i < newCount; i++)
+				{
+					truncated |= digits[i] != 0;
+				}
+				count = std::min(newCount, max_digits);
+				point += added;
+				trim();
+			}
+
+			constexpr void shift(int k) noexcept
+			{
+				if (count == 0)
+				{
+					return;
+				}
+				for (; k > max_shift; k -= max_shift)
+				{
+					shift_left(max_shift);
+				}
+				for (; k < -max_shift; k += max_shift)
+				{
+					shift_right(max_shift);
+				}
+				if (k > 0)
+				{
+					shift_left(k);
+				}
+				else if (k < 0)
+				{
+					shift_right(-k);
+				}
+			}
+
+			// Integer part, rounded half to even
+			constexpr uint64_t rounded_integer() const noexcept
+			{
+				if (point > 20)
+				{
+					return std::numeric_limits<uint64_t>::max();
+				}
+
+				uint64_t n = 0;
+				int i = 0;
+				for (; i < point && i < count; i++)
+				{
+					n = n * 10 + digits[i];
+				}
+				for (; i < point; i++)
+				{
+					n *= 10;
+				}
+
+				bool round_up = false;
+				if (point >= 0 && point < count)
+				{
+					if (digits[point] == 5 && point + 1 == count)
+					{
+						round_up = truncated || (point > 0 && (digits[point - 1] & 1) != 0);
+					}
+					else
+					{
+						round_up = digits[point] >= 5;
+					}
+				}
+				return n + (round_up ? 1 : 0);
+			}
+		};
+
+		// Scales by 2^exponent without leaving the exact range, the last step lands on the (exact) result
+		template <typename float_t>
+		constexpr float_t scale_pow2(float_t value, int exponent) noexcept
+		{
+			for (; exponent > 0; exponent -= std::min(exponent, 60))
+			{
+				value *= static_cast<float_t>(1ull << std::min(exponent, 60));
+			}
+			for (; exponent < 0; exponent += std::min(-exponent, 60))
+			{
+				value /= static_cast<float_t>(1ull << std::min(-exponent, 60));
+			}
+			return value;
+		}
+
+		template <typename float_t>
+		constexpr std::errc parse_float_slow(std::string_view in, float_t& out) noexcept
+		{
+			using info = float_info<float_t>;
+			big_decimal d{};
+
+			size_t i = 0;
+			const bool negative = in[0] == '-';
+			i += negative ? 1 : 0;
+
+			bool sawDot = false;
+			for (; i < in.size(); i++)
+			{
+				const char ch = in[i];
+				if (ch == '.')
+				{
+					sawDot = true;
+					d.point = d.count;
+					continue;
+				}
+				if (is_digit(ch) == false)
+				{
+					break;
+				}
+				if (ch == '0' && d.count == 0)
+				{	// leading zeros only move the point
+					d.point--;
+					continue;
+				}
+				if (d.count < big_decimal::max_digits)
+				{
+					d.digits[d.count++] = static_cast<uint8_t>(ch - '0');
+				}
+				else if (ch != '0')
+				{
+					d.truncated = true;
+				}
+			}
+			if (sawDot == false)
+			{
+				d.point = d.count;
+			}
+
+			if (i < in.size())
+			{	// exponent, already validated by the scanner
+				i++;
+				const bool negExp = in[i] == '-';
+				i += (in[i] == '-' || in[i] == '+') ? 1 : 0;
+				int exp = 0;
+				for (; i < in.size(); i++)
+				{
+					exp = std::min(exp * 10 + (in[i] - '0'), 100000);
+				}
+				d.point += negExp ? -exp : exp;
+			}
+			d.trim();
+
+			constexpr int max_exp = (1 << info::exponent_bits) - 1;
+			int exp = 0;
+			uint64_t mantissa = 0;
+			bool overflow = false;
+			if (d.count == 0)
+			{
+				exp = info::bias;
+			}
+			else if (d.point > 310)
+			{
+				overflow = true;
+			}
+			else if (d.point < -330)
+			{
+				exp = info::bias;
+			}
+			else
+			{
+				constexpr int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+				constexpr int powtab_size = static_cast<int>(sizeof(powtab) / sizeof(powtab[0]));
+				while (d.point > 0)
+				{
+					const int n = (d.point >= powtab_size) ? 27 : powtab[d.point];
+					d.shift(-n);
+					exp += n;
+				}
+				while (d.point < 0 || (d.point == 0 && d.digits[0] < 5))
+				{
+					const int n = (-d.point >= powtab_size) ? 27 : powtab[-d.point];
+					d.shift(n);
+					exp -= n;
+				}
+
+				exp--; // [0.5, 1) -> [1, 2)
+				if (exp < info::bias + 1)
+				{	// denormal
+					const int n = info::bias + 1 - exp;
+					d.shift(-n);
+					exp += n;
+				}
+
+				if (exp - info::bias >= max_exp)
+				{
+					overflow = true;
+				}
+				else
+				{
+					d.shift(1 + info::mantissa_bits);
+					mantissa = d.rounded_integer();
+					if (mantissa == (2ull << info::mantissa_bits))
+					{
+						mantissa >>= 1;
+						exp++;
+						overflow = exp - info::bias >= max_exp;
+					}
+					if ((mantissa & (1ull << info::mantissa_bits)) == 0)
+					{
+						exp = info::bias;
+					}
+				}
+			}
+
+			if (overflow)
+			{
+				return std::errc::result_out_of_range;
+			}
+			if (mantissa == 0 && d.count != 0)
+			{
+				return std::errc::result_out_of_range;
+			}
+
+			// denormals share the exponent of the smallest normal, they just lack the implicit bit
+			const int scale = ((exp == info::bias) ? info::bias + 1 : exp) - info::mantissa_bits;
+			const float_t magnitude = scale_pow2(static_cast<float_t>(mantissa), scale);
+			out = negative ? -magnitude : magnitude;
+			return std::errc{};
+		}
+
+		// Validates the text and pulls out the leading significant digits, eight at a time where possible
+		constexpr std::errc scan_decimal(std::string_view in, decimal_parts& parts) noexcept
+		{
+			const char* p = in.data();
+			const char* end = p + in.size();
+			if (p != end && *p == '-')
+			{
+				parts.negative = true;
+				p++;
+			}
+
+			constexpr uint64_t keep_limit = 1000000000000000000ull; // 10^18, one more digit still fits in 19
+			bool anyDigits = false;
+			const auto take_digits = [&](int64_t taken_step, int64_t dropped_step) constexpr
+			{
+				while (p != end)
+				{
+					if (end - p >= 8 && parts.mantissa <= 99999999999ull)
+					{
+						const uint64_t word = hash_read<false>(p, 8);
+						if (is_eight_digits(word))
+						{
+							parts.mantissa = parts.mantissa * 100000000ull + parse_eight_digits(word);
+							parts.exponent += taken_step * 8;
+							anyDigits = true;
+							p += 8;
+							continue;
+						}
+					}
+
+					if (is_digit(*p) == false)
+					{
+						return;
+					}
+
+					const uint64_t digit = static_cast<uint64_t>(*p - '0');
+					if (parts.mantissa < keep_limit)
+					{
+						parts.mantissa = parts.mantissa * 10 + digit;
+						parts.exponent += taken_step;
+					}
+					else
+					{
+						parts.exponent += dropped_step;
+						parts.truncated |= digit != 0;
+					}
+					anyDigits = true;
+					p++;
+				}
+			};
+
+			take_digits(0, 1);
+			if (p != end && *p == '.')
+			{
+				p++;
+				take_digits(-1, 0);
+			}
+
+			if (anyDigits == false)
+			{
+				return std::errc::invalid_argument;
+			}
+
+			if (p != end && (*p == 'e' || *p == 'E'))
+			{
+				p++;
+				bool negExp = false;
+				if (p != end && (*p == '-' || *p == '+'))
+				{
+					negExp = *p == '-';
+					p++;
+				}
+				if (p == end)
+				{
+					return std::errc::invalid_argument;
+				}
+
+				int64_t exp = 0;
+				for (; p != end && is_digit(*p); p++)
+				{
+					exp = std::min<int64_t>(exp * 10 + (*p - '0'), 100000);
+				}
+				parts.exponent += negExp ? -exp : exp;
+			}
+
+			return (p == end) ? std::errc{} : std::errc::invalid_argument;
+		}
+
+		template <typename float_t>
+		constexpr std::errc parse_float(std::string_view in, float_t& out) noexcept
+		{
+			using info = float_info<float_t>;
+
+			{	// inf/infinity/nan, any case
+				const std::string_view word = (in.empty() == false && in[0] == '-') ? in.substr(1) : in;
+				const bool negative = word.size() != in.size();
+				if (cxpr::iequals(word, "inf") || cxpr::iequals(word, "infinity"))
+				{
+					out = negative ? -std::numeric_limits<float_t>::infinity() : std::numeric_limits<float_t>::infinity();
+					return std::errc{};
+				}
+				if (cxpr::iequals(word, "nan"))
+				{
+					out = negative ? -std::numeric_limits<float_t>::quiet_NaN() : std::numeric_limits<float_t>::quiet_NaN();
+					return std::errc{};
+				}
+			}
+
+			decimal_parts parts{};
+			const auto ec = scan_decimal(in, parts);
+			if (ec != std::errc{})
+			{
+				return ec;
+			}
+
+			// Clinger's fast path: mantissa and power of 10 are both exact, so a single rounding gives the answer
+			if (parts.truncated == false && parts.mantissa <= info::max_exact
+				&& parts.exponent >= -info::max_exact_pow10 && parts.exponent <= info::max_exact_pow10)
+			{
+				float_t value = static_cast<float_t>(parts.mantissa);
+				if (parts.exponent < 0)
+				{
+					value /= info::pow10[-parts.exponent];
+				}
+				else
+				{
+					value *= info::pow10[parts.exponent];
+				}
+				out = parts.negative ? -value : value;
+				return std::errc{};
+			}
+
+			if (parts.mantissa == 0)
+			{	// all zeros, whatever the exponent
+				out = parts.negative ? -float_t(0) : float_t(0);
+				return std::errc{};
+			}
+
+#if defined(__cpp_lib_to_chars)
+			if (__detail::is_constant_evaluated() == false)
+			{	// the standard library's correctly rounded parser agrees with the slow path bit for bit
+				float_t value{};
+				const auto res = std::from_chars(in.data(), in.data() + in.size(), value);
+				if (res.ec == std::errc{} && res.ptr == in.data() + in.size())
+				{
+					out = value;
+					return std::errc{};
+				}
+				if (res.ec == std::errc::result_out_of_range)
+				{
+					return res.ec;
+				}
+			}
+#endif
+			return parse_float_slow(in, out);
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Parses the whole of 'in' as a T, leaving 'out' untouched on failure. Integers are read eight digits per
+	// step with SWAR, floats take Clinger's exact fast path when they can and fall back to a correctly rounded
+	// conversion otherwise
+	//	 int64_t qty = 0;
+	//	 if (cxpr::parse_to(fields[2], qty) != std::errc{}) {...}
+	template <typename T>
+	[[nodiscard]] constexpr std::errc parse_to(std::string_view in, T& out) noexcept
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "only float and double are supported");
+			return __detail::parse_float(in, out);
+		}
+		else
+		{
+			static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "parse needs an integer or floating point type");
+			return __detail::parse_integer(in, out);
+		}
+	}
+
+	// optional_ex flavor of parse_to, empty on failure
+	//	 cxpr::parse<double>(price).map([](double& p) { p *= 100; });
+	template <typename T>
+	[[nodiscard]] constexpr optional_ex<T> parse(std::string_view in) noexcept
+	{
+		T value{};
+		if (parse_to(in, value) != std::errc{})
+		{
+			return optional_ex<T>{};
+		}
+		return optional_ex<T>{ value };
+	}
+}
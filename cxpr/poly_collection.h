@@ -0,0 +1,153 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		template <typename T>
+		constexpr bool is_variant_v = false;
+
+		template <typename ... types_t>
+		constexpr bool is_variant_v<std::variant<types_t...>> = true;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Heterogeneous container that keeps one contiguous std::vector per type instead of a vector of
+	// std::variant. Elements take their own size rather than the size of the largest alternative, and
+	// for_each runs one loop per type with the type known during compile, so there is no dispatch per element.
+	//	 cxpr::poly_collection<cxpr::typeset<circle, square, polygon>> shapes;
+	//	 shapes.insert(circle{ 2.0 });
+	//	 shapes.for_each([&](const auto& shape) { total += shape.area(); });
+	// Elements are visited type by type (in typeset order), and in insertion order within a type
+	template <typename set_t>
+	class poly_collection;
+
+	template <template <typename ...> class set_t, typename ... types_t>
+	class poly_collection<set_t<types_t...>>
+	{
+	public:
+		using types = typeset<types_t...>;
+
+		static constexpr size_t count = sizeof...(types_t);
+		static constexpr size_t max_element_size = max_size<types_t...>::value;
+		static constexpr size_t min_element_size = min_size<types_t...>::value;
+		static_assert(count > 0, "poly_collection needs at least one type");
+		static_assert(assert_unique_typehashes<types>(), "poly_collection types must be unique");
+
+		template <typename T>
+		static constexpr bool contains = __detail::type_index_of<T, types_t...>() != count;
+
+		template <typename T>
+		using segment_t = std::vector<std::decay_t<T>>;
+
+		template <typename T, std::enable_if_t<!__detail::is_variant_v<std::decay_t<T>>, int> = 0>
+		decltype(auto) insert(T&& value)
+		{
+			return segment<T>().emplace_back(std::forward<T>(value));
+		}
+
+		// Moves or copies the value held by a variant into its segment, the one runtime dispatch per element
+		template <typename variant_t, std::enable_if_t<__detail::is_variant_v<std::decay_t<variant_t>>, int> = 0>
+		void insert(variant_t&& value)
+		{
+			cxpr::jump_visit([this](auto&& held) { insert(std::forward<decltype(held)>(held)); }, std::forward<variant_t>(value));
+		}
+
+		template <typename T, typename ... params_t>
+		decltype(auto) emplace(params_t&& ... params)
+		{
+			return segment<T>().emplace_back(std::forward<params_t>(params)...);
+		}
+
+		// The contiguous array holding every T
+		template <typename T>
+		[[nodiscard]] segment_t<T>& segment() noexcept
+		{
+			static_assert(contains<T>, "type is not part of the poly_collection");
+			return std::get<__detail::type_index_of<T, types_t...>()>(segments);
+		}
+
+		template <typename T>
+		[[nodiscard]] const segment_t<T>& segment() const noexcept
+		{
+			static_assert(contains<T>, "type is not part of the poly_collection");
+			return std::get<__detail::type_index_of<T, types_t...>()>(segments);
+		}
+
+		// Calls fun with every element, one tight loop per type
+		template <typename fun_t>
+		void for_each(fun_t&& fun)
+		{
+			std::apply([&](auto& ... segs)
+			{
+				(for_each_in(segs, fun), ...);
+			}, segments);
+		}
+
+		template <typename fun_t>
+		void for_each(fun_t&& fun) const
+		{
+			std::apply([&](const auto& ... segs)
+			{
+				(for_each_in(segs, fun), ...);
+			}, segments);
+		}
+
+		template <typename T>
+		void reserve(size_t n)
+		{
+			segment<T>().reserve(n);
+		}
+
+		void clear() noexcept
+		{
+			std::apply([](auto& ... segs) { (segs.clear(), ...); }, segments);
+		}
+
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return std::apply([](const auto& ... segs) { return (segs.size() + ... + 0); }, segments);
+		}
+
+		template <typename T>
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return segment<T>().size();
+		}
+
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// Bytes taken by the elements themselves (capacity slack not included)
+		[[nodiscard]] size_t payload_bytes() const noexcept
+		{
+			return std::apply([](const auto& ... segs)
+			{
+				return ((segs.size() * sizeof(typename std::decay_t<decltype(segs)>::value_type)) + ... + 0);
+			}, segments);
+		}
+
+		// Padding the same elements would waste as an array of variants, where every slot is sized for the
+		// largest type (the variant's own index byte and alignment padding not counted)
+		[[nodiscard]] size_t variant_padding_bytes() const noexcept
+		{
+			return size() * max_element_size - payload_bytes();
+		}
+
+	private:
+		std::tuple<std::vector<types_t>...> segments;
+
+		template <typename segment_t, typename fun_t>
+		static void for_each_in(segment_t& seg, fun_t& fun)
+		{
+			for (auto& item : seg)
+			{
+				fun(item);
+			}
+		}
+	};
+}
@@ -0,0 +1,486 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	//////////////////////////////////////////////////////////////////////////
+	// One column of a record_schema, name_t is a cxpr::literal
+	//	 constexpr auto qty = CXPR_LITERAL("qty");
+	//	 using qty_field = cxpr::field<decltype(qty), uint32_t>;
+	template <typename name_t, typename T>
+	struct field
+	{
+		static_assert(is_literal_v<name_t>, "field names must be cxpr::literal types");
+
+		using name = name_t;
+		using type = T;
+	};
+
+	// Outcome of a record parse. 'parsed' counts values stored, 'unknown' keys that aren't in the schema.
+	// On failure 'field' is the schema index of the value that didn't parse, npos for a malformed record
+	struct record_parse_result
+	{
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		std::errc error = {};
+		size_t parsed = 0;
+		size_t unknown = 0;
+		size_t field = npos;
+
+		constexpr explicit operator bool() const noexcept { return error == std::errc{}; }
+	};
+
+	namespace __detail
+	{
+		template <typename T>
+		constexpr bool is_basic_fixed_string_v = false;
+
+		template <typename data_t, size_t max_capacity, typename transform, typename overrun_behavior>
+		constexpr bool is_basic_fixed_string_v<basic_fixed_string<data_t, max_capacity, transform, overrun_behavior>> = true;
+
+		// Stores one value into its slot, the slot is left untouched on failure
+		template <typename T>
+		constexpr std::errc parse_field_value(std::string_view in, T& out) noexcept
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				if (in == "true" || in == "1")
+				{
+					out = true;
+					return std::errc{};
+				}
+				if (in == "false" || in == "0")
+				{
+					out = false;
+					return std::errc{};
+				}
+				return std::errc::invalid_argument;
+			}
+			else if constexpr (std::is_arithmetic_v<T>)
+			{
+				return parse_to(in, out);
+			}
+			else if constexpr (std::is_same_v<T, std::string_view>)
+			{
+				out = in;	// points into the record
+				return std::errc{};
+			}
+			else if constexpr (is_basic_fixed_string_v<T>)
+			{
+				static_assert(std::is_same_v<typename T::value_type, char>, "record fields need a char fixed_string");
+				if (in.size() > T::max_sz)
+				{
+					return std::errc::result_out_of_range;
+				}
+				out.clear();
+				out.append(in);
+				return std::errc{};
+			}
+			else
+			{
+				static_assert(sizeof(T) == 0, "record fields must be arithmetic, bool, std::string_view or a fixed_string");
+				return std::errc::invalid_argument;
+			}
+		}
+
+		// Case-folded contents of a field name: its first 16 bytes as two little-endian words, zero past the
+		// end, plus the size. Equal keys mean equal names (ignoring case). Longer names fall back to their
+		// hash_invariant
+		struct field_key
+		{
+			uint64_t a = 0;
+			uint64_t b = 0;
+			size_t size = 0;
+
+			constexpr bool operator==(const field_key& other) const noexcept
+			{
+				return a == other.a && b == other.b && size == other.size;
+			}
+		};
+
+		constexpr uint64_t low_bytes_mask(size_t count) noexcept
+		{
+			return (count >= 8) ? ~uint64_t(0) : ((uint64_t(1) << (count * 8)) - 1);
+		}
+
+		// The bytes of a field_key before case folding. Reads only inside 'in', overlapping reads put the same
+		// byte in the same place
+		constexpr field_key read_field_key(std::string_view in) noexcept
+		{
+			const char* p = in.data();
+			const size_t len = in.size();
+			uint64_t a = 0;
+			uint64_t b = 0;
+			if (len > 16)
+			{
+				return { hash_invariant(in), 0, len };
+			}
+			else if (len >= 8)
+			{
+				a = hash_read<false>(p, 8);
+				b = (len > 8) ? hash_read<false>(p + len - 8, 8) >> ((16 - len) * 8) : 0;
+			}
+			else if (len >= 4)
+			{
+				a = hash_read<false>(p, 4) | (hash_read<false>(p + len - 4, 4) << ((len - 4) * 8));
+			}
+			else if (len > 0)
+			{
+				a = hash_read<false>(p, 1) | (hash_read<false>(p + (len >> 1), 1) << ((len >> 1) * 8))
+					| (hash_read<false>(p + len - 1, 1) << ((len - 1) * 8));
+			}
+			return { a, b, len };
+		}
+
+		// Same bytes without branching on the size, for names up to 16 characters when 16 bytes can be read from p
+		inline field_key read_field_key_overread(const char* p, size_t len) noexcept
+		{
+			const uint64_t a = hash_read<false>(p, 8) & low_bytes_mask(len);
+			const uint64_t b = hash_read<false>(p + 8, 8) & low_bytes_mask((len > 8) ? len - 8 : 0);
+			return { a, b, len };
+		}
+
+		// Longer names are keyed by hash_invariant, which already ignores case
+		constexpr field_key fold_field_key(const field_key& key) noexcept
+		{
+			return (key.size > 16) ? key : field_key{ fold_case_swar(key.a), fold_case_swar(key.b), key.size };
+		}
+
+		constexpr field_key make_field_key(std::string_view in) noexcept
+		{
+			return fold_field_key(read_field_key(in));
+		}
+
+		constexpr cxpr::hash_t field_key_hash(const field_key& key) noexcept
+		{
+			return mum_mix(key.a ^ hash_secret[0], key.b ^ hash_secret[1] ^ key.size);
+		}
+
+		constexpr bool is_json_space(char ch) noexcept
+		{
+			return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+		}
+
+		constexpr size_t skip_json_space(std::string_view in, size_t pos) noexcept
+		{
+			while (pos < in.size() && is_json_space(in[pos]))
+			{
+				pos++;
+			}
+			return pos;
+		}
+
+		// Quoted string starting at pos, escapes aren't decoded so they are refused
+		constexpr bool read_json_string(std::string_view in, size_t& pos, std::string_view& out) noexcept
+		{
+			if (pos >= in.size() || in[pos] != '"')
+			{
+				return false;
+			}
+			const size_t start = pos + 1;
+			size_t end = start;
+			while (end < in.size() && in[end] != '"')
+			{
+				if (in[end] == '\\')
+				{
+					return false;
+				}
+				end++;
+			}
+			if (end == in.size())
+			{
+				return false;
+			}
+			out = in.substr(start, end - start);
+			pos = end + 1;
+			return true;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Maps the field names of text records onto the slots of a std::tuple. A perfect hash over the names is
+	// searched for during compile (see type_map), so finding the slot of a key costs a couple of loads, two
+	// multiplies and one compare instead of a chain of string compares. Values are parsed straight into
+	// their slot with no allocation:
+	//	 constexpr auto sym = CXPR_LITERAL("sym"), px = CXPR_LITERAL("px"), qty = CXPR_LITERAL("qty");
+	//	 using fill_schema = cxpr::record_schema<cxpr::field<decltype(sym), cxpr::fixed_string<16>>,
+	//		 cxpr::field<decltype(px), double>, cxpr::field<decltype(qty), uint32_t>>;
+	//	 fill_schema::tuple_t fill;
+	//	 auto res = fill_schema::parse_kv("sym=AAPL;px=187.25;qty=100", fill);
+	//	 auto res2 = fill_schema::parse_json(R"({"sym": "AAPL", "px": 187.25, "qty": 100})", fill);
+	// Names match case-insensitively, like hash_invariant. Names longer than 16 characters are matched by
+	// their hash_invariant alone, a key sharing that 64 bit hash would be taken for the name.
+	// Slots may be arithmetic, bool (true/false/1/0), std::string_view (a view into the record) or a char
+	// fixed_string (too long values fail with result_out_of_range).
+	// A few fields that always come in the same order are still parsed a little faster by an if/else chain,
+	// the lookup is then as cheap as its compares but handing each value to its slot costs a few cycles more
+	template <typename ... fields_t>
+	class record_schema
+	{
+	public:
+		using tuple_t = std::tuple<typename fields_t::type...>;
+		using index_t = std::conditional_t<(sizeof...(fields_t) < 256), uint8_t, uint16_t>;
+
+		static constexpr size_t npos = static_cast<size_t>(-1);
+		static constexpr size_t count = sizeof...(fields_t);
+		static_assert(count > 0, "record_schema needs at least one field");
+
+	private:
+		static constexpr std::array<__detail::field_key, count> keys = { __detail::make_field_key(fields_t::name::view())... };
+		static constexpr std::array<cxpr::hash_t, count> hashes = { __detail::field_key_hash(__detail::make_field_key(fields_t::name::view()))... };
+
+		static constexpr bool unique_names() noexcept
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				for (size_t j = i + 1; j < count; j++)
+				{
+					if (keys[i] == keys[j])
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+		static_assert(unique_names(), "record_schema field names must be unique (they are compared case-insensitively)");
+
+		static constexpr __detail::perfect_hash_params params = __detail::find_perfect_hash(hashes);
+
+		static constexpr auto slots = __detail::perfect_hash_slots<index_t, params.bits>(hashes, params);
+
+		// Slots of the same type share one parse: the field index picks a distinct type and the slot is
+		// reached through a pointer, so wide records of a few types don't inline a parse per field
+		using slot_types = typeset_unique_t<typeset<typename fields_t::type...>>;
+		static constexpr size_t slot_type_count = __detail::typeset_unpack<slot_types>::size;
+		static constexpr std::array<index_t, count> slot_type = {
+			static_cast<index_t>(typeset_index_of_v<typename fields_t::type, slot_types>)... };
+
+		template <size_t ... idx>
+		static constexpr std::array<void*, count> slot_pointers(tuple_t& record, std::index_sequence<idx...>) noexcept
+		{
+			return { static_cast<void*>(&std::get<idx>(record))... };
+		}
+
+		template <size_t ... type_idx>
+		static std::errc parse_typed_slot(size_t type, std::string_view value, void* slot, std::index_sequence<type_idx...>) noexcept
+		{
+			std::errc error = std::errc{};
+			static_cast<void>(((type == type_idx
+				&& (error = __detail::parse_field_value(value, *static_cast<typeset_element_t<type_idx, slot_types>*>(slot)), true)) || ...));
+			return error;
+		}
+
+		// Pointers can't be cast back from void* during compile, there every field gets its own parse
+		template <size_t ... idx>
+		static constexpr std::errc parse_slot(size_t slot, std::string_view value, tuple_t& record, std::index_sequence<idx...>) noexcept
+		{
+			std::errc error = std::errc{};
+			static_cast<void>(((slot == idx && (error = __detail::parse_field_value(value, std::get<idx>(record)), true)) || ...));
+			return error;
+		}
+
+		static constexpr size_t find_key(const __detail::field_key& key) noexcept
+		{
+			const size_t idx = slots[__detail::perfect_hash_slot(__detail::field_key_hash(key), params)];
+			return (keys[idx] == key) ? idx : npos;
+		}
+
+		// Keys inside a record can be read 16 bytes at a time while that stays inside the record, which
+		// skips the branches on the key size. Records usually list their fields in the same order, so the
+		// field after the previous one is tried first, against the key as written: the names are stored
+		// folded, so a key spelled the same way matches without folding it
+		static constexpr size_t find_in_record(std::string_view key, std::string_view record_text, size_t& expected) noexcept
+		{
+			const __detail::field_key raw = (__detail::is_constant_evaluated() == false && key.size() <= 16
+				&& static_cast<size_t>(record_text.data() + record_text.size() - key.data()) >= 16)
+				? __detail::read_field_key_overread(key.data(), key.size()) : __detail::read_field_key(key);
+
+			const size_t idx = (keys[expected] == raw) ? expected : find_key(__detail::fold_field_key(raw));
+			if (idx != npos)
+			{
+				expected = (idx + 1 == count) ? 0 : idx + 1;
+			}
+			return idx;
+		}
+
+		static constexpr void store_field(size_t idx, std::string_view value, tuple_t& record,
+			const std::array<void*, count>& slots_of_record, record_parse_result& result) noexcept
+		{
+			if (idx == npos)
+			{
+				result.unknown++;
+				return;
+			}
+
+			const std::errc error = __detail::is_constant_evaluated()
+				? parse_slot(idx, value, record, std::make_index_sequence<count>{})
+				: parse_typed_slot(slot_type[idx], value, slots_of_record[idx], std::make_index_sequence<slot_type_count>{});
+			if (error != std::errc{})
+			{
+				result.error = error;
+				result.field = idx;
+				return;
+			}
+			result.parsed++;
+		}
+
+	public:
+		template <typename name_t>
+		static constexpr size_t index_of = __detail::type_index_of<name_t, typename fields_t::name...>();
+
+		template <typename name_t>
+		static constexpr bool contains = index_of<name_t> != count;
+
+		// Slot of a runtime field name, npos if it isn't in the schema
+		[[nodiscard]] static constexpr size_t find_index(std::string_view key) noexcept
+		{
+			return find_key(__detail::make_field_key(key));
+		}
+
+		template <typename name_t>
+		[[nodiscard]] static constexpr decltype(auto) get(tuple_t& record) noexcept
+		{
+			static_assert(contains<name_t>, "field is not part of the record_schema");
+			return std::get<index_of<name_t>>(record);
+		}
+
+		template <typename name_t>
+		[[nodiscard]] static constexpr decltype(auto) get(const tuple_t& record) noexcept
+		{
+			static_assert(contains<name_t>, "field is not part of the record_schema");
+			return std::get<index_of<name_t>>(record);
+		}
+
+		// Parses value into the slot named by key. Unknown keys are counted and skipped
+		static constexpr void parse_field(std::string_view key, std::string_view value, tuple_t& record, record_parse_result& result) noexcept
+		{
+			store_field(find_index(key), value, record, slot_pointers(record, std::make_index_sequence<count>{}), result);
+		}
+
+		// "key=value;key=value", empty pairs are skipped, a pair without kv_delim is invalid_argument.
+		// Stops at the first value that doesn't parse
+		[[nodiscard]] static constexpr record_parse_result parse_kv(std::string_view text, tuple_t& record,
+			char pair_delim = ';', char kv_delim = '=') noexcept
+		{
+			record_parse_result result;
+			const std::array<void*, count> slots_of_record = slot_pointers(record, std::make_index_sequence<count>{});
+			size_t expected = 0;
+			auto splitter = make_splitter(text, pair_delim, true);
+			std::string_view pair;
+			while (splitter.next(pair))
+			{
+				const size_t split = pair.find(kv_delim);
+				if (split == std::string_view::npos)
+				{
+					result.error = std::errc::invalid_argument;
+					return result;
+				}
+
+				store_field(find_in_record(pair.substr(0, split), text, expected), pair.substr(split + 1), record, slots_of_record, result);
+				if (!result)
+				{
+					return result;
+				}
+			}
+			return result;
+		}
+
+		// One flat JSON object: string keys with string, number, true/false or null values. Nested objects and
+		// arrays, and strings with escapes, are invalid_argument. null leaves the slot untouched, and quoted
+		// numbers are accepted for numeric slots
+		[[nodiscard]] static constexpr record_parse_result parse_json(std::string_view text, tuple_t& record) noexcept
+		{
+			record_parse_result result;
+			const std::array<void*, count> slots_of_record = slot_pointers(record, std::make_index_sequence<count>{});
+			size_t expected = 0;
+			auto malformed = [&result]()
+			{
+				result.error = std::errc::invalid_argument;
+				return result;
+			};
+
+			size_t pos = __detail::skip_json_space(text, 0);
+			if (pos == text.size() || text[pos] != '{')
+			{
+				return malformed();
+			}
+
+			pos = __detail::skip_json_space(text, pos + 1);
+			if (pos < text.size() && text[pos] == '}')
+			{
+				pos++;
+			}
+			else
+			{
+				while (true)
+				{
+					std::string_view key;
+					if (__detail::read_json_string(text, pos, key) == false)
+					{
+						return malformed();
+					}
+
+					pos = __detail::skip_json_space(text, pos);
+					if (pos == text.size() || text[pos] != ':')
+					{
+						return malformed();
+					}
+					pos = __detail::skip_json_space(text, pos + 1);
+
+					std::string_view value;
+					const bool quoted = pos < text.size() && text[pos] == '"';
+					if (quoted)
+					{
+						if (__detail::read_json_string(text, pos, value) == false)
+						{
+							return malformed();
+						}
+					}
+					else
+					{
+						const size_t start = pos;
+						while (pos < text.size() && text[pos] != ',' && text[pos] != '}' && !__detail::is_json_space(text[pos]))
+						{
+							pos++;
+						}
+						value = text.substr(start, pos - start);
+						if (value.empty() || value[0] == '{' || value[0] == '[')
+						{
+							return malformed();
+						}
+					}
+
+					if (quoted || value != "null")
+					{
+						store_field(find_in_record(key, text, expected), value, record, slots_of_record, result);
+						if (!result)
+						{
+							return result;
+						}
+					}
+
+					pos = __detail::skip_json_space(text, pos);
+					if (pos < text.size() && text[pos] == ',')
+					{
+						pos = __detail::skip_json_space(text, pos + 1);
+						continue;
+					}
+					if (pos < text.size() && text[pos] == '}')
+					{
+						pos++;
+						break;
+					}
+					return malformed();
+				}
+			}
+
+			if (__detail::skip_json_space(text, pos) != text.size())
+			{
+				return malformed();
+			}
+			return result;
+		}
+	};
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	template <typename T>
+	class serial_view;
+
+	template <typename T>
+	class serial_array_view;
+
+	namespace __detail
+	{
+		template <typename T, typename = void>
+		constexpr bool is_tuple_like_v = false;
+
+		template <typename T>
+		constexpr bool is_tuple_like_v<T, std::void_t<decltype(std::tuple_size<T>::value)>> = true;
+
+		template <typename T>
+		constexpr bool is_trivial_array_v = false;
+
+		template <typename T, size_t n>
+		constexpr bool is_trivial_array_v<std::array<T, n>> = std::is_trivially_copyable_v<T>;
+
+		using serial_count_t = uint32_t;
+
+		// Largest capacity written through a block on the stack, see serial_store_padded
+		constexpr size_t serial_padded_block_limit = 128;
+
+		// Copies the used bytes and clears the rest of the capacity. Small capacities go through a block of
+		// fixed size, so the compiler emits a few moves instead of variable sized memcpy/memset calls
+		template <size_t capacity_bytes>
+		void serial_store_padded(unsigned char* out, const void* src, size_t used_bytes) noexcept
+		{
+			if constexpr (capacity_bytes <= serial_padded_block_limit)
+			{
+				unsigned char block[2 * capacity_bytes];
+				std::memcpy(block, src, capacity_bytes);
+				std::memset(block + used_bytes, 0, capacity_bytes);
+				std::memcpy(out, block, capacity_bytes);
+			}
+			else
+			{
+				std::memcpy(out, src, used_bytes);
+				std::memset(out + used_bytes, 0, capacity_bytes - used_bytes);
+			}
+		}
+
+		inline void serial_store_count(unsigned char* out, size_t count) noexcept
+		{
+			const auto value = static_cast<serial_count_t>(count);
+			std::memcpy(out, &value, sizeof(value));
+		}
+
+		template <size_t capacity>
+		size_t serial_load_count(const unsigned char* in)
+		{
+			serial_count_t value;
+			std::memcpy(&value, in, sizeof(value));
+			if (value > capacity)
+			{
+				throw std::length_error("serialized count is larger than the container's capacity");
+			}
+			return value;
+		}
+
+		// How each type is laid out on the wire. Every encoding has a fixed size, so every field of a record
+		// sits at an offset known during compile
+		template <typename T, typename = void>
+		struct serial_traits
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "type can't be serialized: it must be trivially copyable, a tuple, "
+				"a fixed_string or a fixed_vector");
+
+			// Copied as raw bytes
+			static constexpr size_t size = sizeof(T);
+			static constexpr bool blob = true;
+			using view_t = T;
+
+			static void write(const T& value, unsigned char* out) noexcept
+			{
+				std::memcpy(out, &value, sizeof(T));
+			}
+
+			static void read(const unsigned char* in, T& value) noexcept
+			{
+				std::memcpy(&value, in, sizeof(T));
+			}
+
+			static view_t view(const unsigned char* in) noexcept
+			{
+				T value;
+				read(in, value);
+				return value;
+			}
+		};
+
+		// Tuples, pairs, packed_tuples and arrays of non-trivial types, one field after the other
+		template <typename T>
+		struct serial_traits<T, std::enable_if_t<is_tuple_like_v<T> && !is_trivial_array_v<T>>>
+		{
+			static constexpr size_t count = std::tuple_size_v<T>;
+
+			template <size_t ... idx>
+			static constexpr std::array<size_t, count + 1> make_offsets(std::index_sequence<idx...>) noexcept
+			{
+				constexpr size_t sizes[] = { serial_traits<std::tuple_element_t<idx, T>>::size..., 0 };
+				std::array<size_t, count + 1> out{};
+				for (size_t i = 0; i < count; i++)
+				{
+					out[i + 1] = out[i] + sizes[i];
+				}
+				return out;
+			}
+
+			static constexpr std::array<size_t, count + 1> offsets = make_offsets(std::make_index_sequence<count>{});
+			static constexpr size_t size = offsets[count];
+			static constexpr bool blob = false;
+			using view_t = serial_view<T>;
+
+			template <size_t ... idx>
+			static void write_fields(const T& value, unsigned char* out, std::index_sequence<idx...>)
+			{
+				using std::get;
+				(serial_traits<std::tuple_element_t<idx, T>>::write(get<idx>(value), out + offsets[idx]), ...);
+			}
+
+			template <size_t ... idx>
+			static void read_fields(const unsigned char* in, T& value, std::index_sequence<idx...>)
+			{
+				using std::get;
+				(serial_traits<std::tuple_element_t<idx, T>>::read(in + offsets[idx], get<idx>(value)), ...);
+			}
+
+			static void write(const T& value, unsigned char* out)
+			{
+				write_fields(value, out, std::make_index_sequence<count>{});
+			}
+
+			static void read(const unsigned char* in, T& value)
+			{
+				read_fields(in, value, std::make_index_sequence<count>{});
+			}
+
+			static view_t view(const unsigned char* in) noexcept
+			{
+				return view_t(in);
+			}
+		};
+
+		// Count, then the whole capacity so the encoding keeps a fixed size. The unused tail is zeroed
+		template <typename data_t, size_t max_capacity, typename transform, typename overrun_behavior>
+		struct serial_traits<basic_fixed_string<data_t, max_capacity, transform, overrun_behavior>>
+		{
+			using string_t = basic_fixed_string<data_t, max_capacity, transform, overrun_behavior>;
+			static constexpr size_t capacity = string_t::max_sz;
+			static constexpr size_t size = sizeof(serial_count_t) + capacity * sizeof(data_t);
+			static constexpr bool blob = false;
+			using view_t = std::basic_string_view<data_t>;
+
+			static void write(const string_t& value, unsigned char* out) noexcept
+			{
+				serial_store_count(out, value.size());
+				serial_store_padded<capacity * sizeof(data_t)>(out + sizeof(serial_count_t), value.data(), value.size() * sizeof(data_t));
+			}
+
+			static void read(const unsigned char* in, string_t& value)
+			{
+				const size_t count = serial_load_count<capacity>(in);
+				value.clear();
+				if constexpr (sizeof(data_t) == 1)
+				{
+					value.append(view_t(reinterpret_cast<const data_t*>(in + sizeof(serial_count_t)), count));
+				}
+				else
+				{
+					std::array<data_t, capacity> chars;
+					std::memcpy(chars.data(), in + sizeof(serial_count_t), count * sizeof(data_t));
+					value.append(view_t(chars.data(), count));
+				}
+			}
+
+			// The characters are used in place
+			static view_t view(const unsigned char* in)
+			{
+				static_assert(alignof(data_t) == 1, "wide strings may be misaligned in the buffer, deserialize them instead");
+				return view_t(reinterpret_cast<const data_t*>(in + sizeof(serial_count_t)), serial_load_count<capacity>(in));
+			}
+		};
+
+		// Count, then every slot of the capacity. Trivially copyable elements are copied with one memcpy
+		template <typename T, size_t max_sz>
+		struct serial_traits<fixed_vector<T, max_sz>>
+		{
+			using vector_t = fixed_vector<T, max_sz>;
+			using element_traits = serial_traits<T>;
+			static constexpr size_t size = sizeof(serial_count_t) + max_sz * element_traits::size;
+			static constexpr bool blob = false;
+			using view_t = serial_array_view<T>;
+
+			static void write(const vector_t& value, unsigned char* out)
+			{
+				serial_store_count(out, value.size());
+				out += sizeof(serial_count_t);
+				if constexpr (element_traits::blob)
+				{
+					serial_store_padded<max_sz * sizeof(T)>(out, &value[0], value.size() * sizeof(T));
+				}
+				else
+				{
+					std::memset(out, 0, max_sz * element_traits::size);
+					for (size_t i = 0; i < value.size(); i++)
+					{
+						element_traits::write(value[i], out + i * element_traits::size);
+					}
+				}
+			}
+
+			static void read(const unsigned char* in, vector_t& value)
+			{
+				const size_t count = serial_load_count<max_sz>(in);
+				in += sizeof(serial_count_t);
+				value.clear();
+				for (size_t i = 0; i < count; i++)
+				{
+					value.push_back(T{});
+				}
+				if constexpr (element_traits::blob)
+				{
+					if (count != 0)
+					{
+						std::memcpy(&value[0], in, count * sizeof(T));
+					}
+				}
+				else
+				{
+					for (size_t i = 0; i < count; i++)
+					{
+						element_traits::read(in + i * element_traits::size, value[i]);
+					}
+				}
+			}
+
+			static view_t view(const unsigned char* in)
+			{
+				return view_t(in + sizeof(serial_count_t), serial_load_count<max_sz>(in));
+			}
+		};
+	}
+
+	// Number of bytes serialize writes for a T, the same for every value
+	template <typename T>
+	constexpr size_t serialized_size_v = __detail::serial_traits<T>::size;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Binary encoding of tuples (std::tuple, std::pair, packed_tuple) of trivially copyable types,
+	// fixed_strings and fixed_vectors, nested in any way. The layout is generated during compile: fields are
+	// packed one after the other with no padding, and fixed_strings/fixed_vectors always take their whole
+	// capacity, so every field sits at a constant offset and the compiler merges neighbouring copies.
+	//	 using fill_t = std::tuple<uint64_t, cxpr::fixed_string<16>, double, cxpr::fixed_vector<uint32_t, 8>>;
+	//	 auto bytes = cxpr::serialize(fill);				// std::array<unsigned char, serialized_size_v<fill_t>>
+	//	 auto copy = cxpr::deserialize<fill_t>(bytes.data(), bytes.size());
+	// Values are stored in the machine's byte order, it's meant for processes on the same host
+	template <typename T>
+	unsigned char* serialize(const T& value, unsigned char* out)
+	{
+		__detail::serial_traits<T>::write(value, out);
+		return out + serialized_size_v<T>;
+	}
+
+	template <typename T>
+	std::array<unsigned char, serialized_size_v<T>> serialize(const T& value)
+	{
+		std::array<unsigned char, serialized_size_v<T>> out;
+		serialize(value, out.data());
+		return out;
+	}
+
+	// Throws std::out_of_range if the buffer is too small, std::length_error if a stored count doesn't fit
+	// the container it is read into
+	template <typename T>
+	void deserialize(const unsigned char* in, size_t size, T& value)
+	{
+		if (size < serialized_size_v<T>)
+		{
+			throw std::out_of_range("buffer is smaller than the serialized type");
+		}
+		__detail::serial_traits<T>::read(in, value);
+	}
+
+	template <typename T>
+	T deserialize(const unsigned char* in, size_t size)
+	{
+		T value{};
+		deserialize(in, size, value);
+		return value;
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Reads the fields of a serialized tuple in place, without deserializing the rest. get<I> gives
+	// trivially copyable fields by value, fixed_strings as a string_view into the buffer, fixed_vectors as a
+	// serial_array_view and nested tuples as another serial_view. The buffer must outlive the view
+	//	 cxpr::serial_view<fill_t> view(bytes.data(), bytes.size());
+	//	 if (view.get<1>() == "XNAS") { total += view.get<2>(); }
+	template <typename T>
+	class serial_view
+	{
+		using traits_t = __detail::serial_traits<T>;
+		static_assert(__detail::is_tuple_like_v<T>, "serial_view reads tuples, deserialize other types");
+
+	public:
+		template <size_t idx>
+		using element_t = std::tuple_element_t<idx, T>;
+
+		// Throws std::out_of_range if the buffer is too small
+		serial_view(const unsigned char* in, size_t size) : data(in)
+		{
+			if (size < serialized_size_v<T>)
+			{
+				throw std::out_of_range("buffer is smaller than the serialized type");
+			}
+		}
+
+		template <size_t idx>
+		[[nodiscard]] typename __detail::serial_traits<element_t<idx>>::view_t get() const
+		{
+			return __detail::serial_traits<element_t<idx>>::view(data + traits_t::offsets[idx]);
+		}
+
+		[[nodiscard]] T materialize() const
+		{
+			T value{};
+			traits_t::read(data, value);
+			return value;
+		}
+
+	private:
+		template <typename, typename>
+		friend struct __detail::serial_traits;
+
+		explicit serial_view(const unsigned char* in) noexcept : data(in) {}
+
+		const unsigned char* data;
+	};
+
+	// Elements of a serialized fixed_vector, read in place
+	template <typename T>
+	class serial_array_view
+	{
+		using traits_t = __detail::serial_traits<T>;
+
+	public:
+		[[nodiscard]] size_t size() const noexcept { return count; }
+		[[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+		[[nodiscard]] typename traits_t::view_t operator[](size_t idx) const
+		{
+			return traits_t::view(data + idx * traits_t::size);
+		}
+
+	private:
+		template <typename, typename>
+		friend struct __detail::serial_traits;
+
+		serial_array_view(const unsigned char* in, size_t size) noexcept : data(in), count(size) {}
+
+		const unsigned char* data;
+		size_t count;
+	};
+}
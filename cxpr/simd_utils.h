@@ -0,0 +1,444 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+// Vectorized building blocks for the string classes. Everything here has a constexpr scalar twin
+// that produces identical results, the vector versions are only picked when the call isn't being
+// constant evaluated. Define CXPR_NO_SIMD to force the scalar paths everywhere.
+
+#if !defined(CXPR_NO_SIMD)
+	#if defined(__AVX2__)
+		#define CXPR_AVX2 1
+	#endif
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define CXPR_SSE2 1
+	#endif
+#endif
+
+#if defined(CXPR_AVX2)
+	#include <immintrin.h>
+#elif defined(CXPR_SSE2)
+	#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+	#define CXPR_NOINLINE __declspec(noinline)
+#else
+	#define CXPR_NOINLINE __attribute__((noinline))
+#endif
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		inline uint32_t count_trailing_zeros(uint32_t mask) noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			unsigned long idx = 0;
+			_BitScanForward(&idx, mask);
+			return static_cast<uint32_t>(idx);
+#else
+			return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// scalar implementations, these define the expected results of the vector versions
+
+		// Returns the index of the first element that differs, or count if the ranges match
+		template <typename char_t>
+		constexpr size_t scalar_mismatch(const char_t* l, const char_t* r, size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				if (l[i] != r[i])
+				{
+					return i;
+				}
+			}
+			return count;
+		}
+
+		// Returns the index of the first occurrence of ch, or count if it isn't present
+		template <typename char_t>
+		constexpr size_t scalar_find(const char_t* str, size_t count, char_t ch) noexcept
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				if (str[i] == ch)
+				{
+					return i;
+				}
+			}
+			return count;
+		}
+
+		// Returns the index of the first occurrence of needle, or count if it isn't present
+		template <typename char_t>
+		constexpr size_t scalar_find(const char_t* str, size_t count, const char_t* needle, size_t needleCount) noexcept
+		{
+			if (needleCount > count)
+			{
+				return count;
+			}
+
+			for (size_t i = 0; i <= count - needleCount; i++)
+			{
+				if (scalar_mismatch(str + i, needle, needleCount) == needleCount)
+				{
+					return i;
+				}
+			}
+			return count;
+		}
+
+		template <typename char_t>
+		constexpr char_t scalar_fold_lower(char_t in) noexcept
+		{
+			return (in >= char_t('A') && in <= char_t('Z')) ? static_cast<char_t>(in + (char_t('a') - char_t('A'))) : in;
+		}
+
+		// Copies count characters while flipping the case of ASCII letters in the source case
+		template <bool to_upper, typename char_t>
+		constexpr void scalar_change_case(char_t* out, const char_t* in, size_t count) noexcept
+		{
+			constexpr char_t first = to_upper ? char_t('a') : char_t('A');
+			constexpr char_t last = to_upper ? char_t('z') : char_t('Z');
+			for (size_t i = 0; i < count; i++)
+			{
+				const char_t ch = in[i];
+				out[i] = (ch >= first && ch <= last) ? static_cast<char_t>(ch ^ char_t(0x20)) : ch;
+			}
+		}
+
+		// Same as scalar_mismatch, but ASCII letters match regardless of case
+		template <typename char_t>
+		constexpr size_t scalar_imismatch(const char_t* l, const char_t* r, size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				if (scalar_fold_lower(l[i]) != scalar_fold_lower(r[i]))
+				{
+					return i;
+				}
+			}
+			return count;
+		}
+
+		// Returns the number of leading code units below 0x80
+		template <typename char_t>
+		constexpr size_t scalar_ascii_prefix(const char_t* str, size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				if (static_cast<std::make_unsigned_t<char_t>>(str[i]) >= 0x80)
+				{
+					return i;
+				}
+			}
+			return count;
+		}
+
+		//////////////////////////////////////////////////////////////////////////
+		// vector implementations, runtime only
+
+		inline size_t vector_mismatch(const char* l, const char* r, size_t count) noexcept
+		{
+			size_t i = 0;
+#if defined(CXPR_AVX2)
+			for (; i + 32 <= count; i += 32)
+			{
+				const __m256i lv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+				const __m256i rv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+				const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lv, rv)));
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask);
+				}
+			}
+#endif
+#if defined(CXPR_SSE2)
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m128i lv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + i));
+				const __m128i rv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lv, rv))) ^ 0xFFFFu;
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask);
+				}
+			}
+#endif
+			return i + scalar_mismatch(l + i, r + i, count - i);
+		}
+
+		inline size_t vector_find(const char* str, size_t count, char ch) noexcept
+		{
+			size_t i = 0;
+#if defined(CXPR_AVX2)
+			const __m256i wide = _mm256_set1_epi8(ch);
+			for (; i + 32 <= count; i += 32)
+			{
+				const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+				const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wide)));
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask);
+				}
+			}
+#endif
+#if defined(CXPR_SSE2)
+			const __m128i narrow = _mm_set1_epi8(ch);
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, narrow)));
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask);
+				}
+			}
+#endif
+			return i + scalar_find(str + i, count - i, ch);
+		}
+
+		// Case changes are a range check plus an xor of the 0x20 bit, the signed compares leave non-ASCII bytes alone
+		template <bool to_upper>
+		inline void vector_change_case(char* out, const char* in, size_t count) noexcept
+		{
+			constexpr char first = to_upper ? 'a' : 'A';
+			constexpr char last = to_upper ? 'z' : 'Z';
+
+			size_t i = 0;
+#if defined(CXPR_AVX2)
+			const __m256i wide_lo = _mm256_set1_epi8(first - 1);
+			const __m256i wide_hi = _mm256_set1_epi8(last + 1);
+			const __m256i wide_bit = _mm256_set1_epi8(0x20);
+			for (; i + 32 <= count; i += 32)
+			{
+				const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+				const __m256i letters = _mm256_and_si256(_mm256_cmpgt_epi8(block, wide_lo), _mm256_cmpgt_epi8(wide_hi, block));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(block, _mm256_and_si256(letters, wide_bit)));
+			}
+#endif
+#if defined(CXPR_SSE2)
+			const __m128i lo = _mm_set1_epi8(first - 1);
+			const __m128i hi = _mm_set1_epi8(last + 1);
+			const __m128i bit = _mm_set1_epi8(0x20);
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(block, lo), _mm_cmplt_epi8(block, hi));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(block, _mm_and_si128(letters, bit)));
+			}
+#endif
+			scalar_change_case<to_upper>(out + i, in + i, count - i);
+		}
+
+		// Lowercases both sides a block at a time and compares, no folded copies are made
+		inline size_t vector_imismatch(const char* l, const char* r, size_t count) noexcept
+		{
+			size_t i = 0;
+#if defined(CXPR_AVX2)
+			const __m256i wide_lo = _mm256_set1_epi8('A' - 1);
+			const __m256i wide_hi = _mm256_set1_epi8('Z' + 1);
+			const __m256i wide_bit = _mm256_set1_epi8(0x20);
+			for (; i + 32 <= count; i += 32)
+			{
+				__m256i lv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+				__m256i rv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+				lv = _mm256_or_si256(lv, _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi8(lv, wide_lo), _mm256_cmpgt_epi8(wide_hi, lv)), wide_bit));
+				rv = _mm256_or_si256(rv, _mm256_and_si256(_mm256_and_si256(_mm256_cmpgt_epi8(rv, wide_lo), _mm256_cmpgt_epi8(wide_hi, rv)), wide_bit));
+				const auto mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lv, rv)));
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask);
+				}
+			}
+#endif
+#if defined(CXPR_SSE2)
+			const __m128i lo = _mm_set1_epi8('A' - 1);
+			const __m128i hi = _mm_set1_epi8('Z' + 1);
+			const __m128i bit = _mm_set1_epi8(0x20);
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i lv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + i));
+				__m128i rv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+				lv = _mm_or_si128(lv, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(lv, lo), _mm_cmplt_epi8(lv, hi)), bit));
+				rv = _mm_or_si128(rv, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(rv, lo), _mm_cmplt_epi8(rv, hi)), bit));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lv, rv))) ^ 0xFFFFu;
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask);
+				}
+			}
+#endif
+			return i + scalar_imismatch(l + i, r + i, count - i);
+		}
+
+		// Works for 1, 2 and 4 byte units: masking off the ASCII bits leaves a unit all-zero bytes only if it's ASCII.
+		// Only reached for inputs of at least one block and kept out of line, otherwise g++ flags the (dead) vector
+		// loads against short arrays whose length it can't see, e.g. string_views over small u"" literals
+		template <typename char_t>
+		CXPR_NOINLINE size_t vector_ascii_prefix(const char_t* str, size_t count) noexcept
+		{
+			constexpr size_t per_block = 16 / sizeof(char_t);
+			size_t i = 0;
+#if defined(CXPR_SSE2)
+			const __m128i high = (sizeof(char_t) == 1) ? _mm_set1_epi8(static_cast<char>(0x80))
+				: (sizeof(char_t) == 2) ? _mm_set1_epi16(static_cast<short>(0xFF80)) : _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + per_block <= count; i += per_block)
+			{
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+				const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(block, high), zero))) ^ 0xFFFFu;
+				if (mask != 0)
+				{
+					return i + count_trailing_zeros(mask) / sizeof(char_t);
+				}
+			}
+#endif
+			return i + scalar_ascii_prefix(str + i, count - i);
+		}
+
+		// Substring search, filters candidate positions by comparing the first and last needle characters
+		// 16 positions at a time and only verifies the middle of the needle for the survivors
+		inline size_t vector_find(const char* str, size_t count, const char* needle, size_t needleCount) noexcept
+		{
+			if (needleCount > count)
+			{
+				return count;
+			}
+			if (needleCount <= 1)
+			{
+				return needleCount == 0 ? 0 : vector_find(str, count, needle[0]);
+			}
+
+			size_t i = 0;
+#if defined(CXPR_SSE2)
+			const size_t last = needleCount - 1;
+			const __m128i first_v = _mm_set1_epi8(needle[0]);
+			const __m128i last_v = _mm_set1_epi8(needle[last]);
+			for (; i + last + 16 <= count; i += 16)
+			{
+				const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+				const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i + last));
+				auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+					_mm_and_si128(_mm_cmpeq_epi8(block_first, first_v), _mm_cmpeq_epi8(block_last, last_v))));
+				while (mask != 0)
+				{
+					const size_t candidate = i + count_trailing_zeros(mask);
+					if (scalar_mismatch(str + candidate + 1, needle + 1, last - 1) == last - 1)
+					{
+						return candidate;
+					}
+					mask &= mask - 1;
+				}
+			}
+#endif
+			const size_t found = scalar_find(str + i, count - i, needle, needleCount);
+			return found == count - i ? count : i + found;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Dispatchers, the vector versions only handle single byte characters
+
+	template <typename char_t>
+	[[nodiscard]] constexpr size_t mismatch_index(const char_t* l, const char_t* r, size_t count) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			if (__detail::is_constant_evaluated() == false)
+			{
+				return __detail::vector_mismatch(reinterpret_cast<const char*>(l), reinterpret_cast<const char*>(r), count);
+			}
+		}
+		return __detail::scalar_mismatch(l, r, count);
+	}
+
+	template <typename char_t>
+	[[nodiscard]] constexpr size_t find_index(const char_t* str, size_t count, char_t ch) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			if (__detail::is_constant_evaluated() == false)
+			{
+				return __detail::vector_find(reinterpret_cast<const char*>(str), count, static_cast<char>(ch));
+			}
+		}
+		return __detail::scalar_find(str, count, ch);
+	}
+
+	template <typename char_t>
+	[[nodiscard]] constexpr size_t find_index(const char_t* str, size_t count, const char_t* needle, size_t needleCount) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			if (__detail::is_constant_evaluated() == false)
+			{
+				return __detail::vector_find(reinterpret_cast<const char*>(str), count,
+					reinterpret_cast<const char*>(needle), needleCount);
+			}
+		}
+		return __detail::scalar_find(str, count, needle, needleCount);
+	}
+
+	// Case-insensitive (ASCII) version of mismatch_index
+	template <typename char_t>
+	[[nodiscard]] constexpr size_t imismatch_index(const char_t* l, const char_t* r, size_t count) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			if (__detail::is_constant_evaluated() == false)
+			{
+				return __detail::vector_imismatch(reinterpret_cast<const char*>(l), reinterpret_cast<const char*>(r), count);
+			}
+		}
+		return __detail::scalar_imismatch(l, r, count);
+	}
+
+	// Copies count characters from in to out, lowercasing ASCII letters. in and out may be the same buffer
+	template <typename char_t>
+	constexpr void lower_case_copy(char_t* out, const char_t* in, size_t count) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			if (__detail::is_constant_evaluated() == false)
+			{
+				__detail::vector_change_case<false>(reinterpret_cast<char*>(out), reinterpret_cast<const char*>(in), count);
+				return;
+			}
+		}
+		__detail::scalar_change_case<false>(out, in, count);
+	}
+
+	// Copies count characters from in to out, uppercasing ASCII letters. in and out may be the same buffer
+	template <typename char_t>
+	constexpr void upper_case_copy(char_t* out, const char_t* in, size_t count) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1)
+		{
+			if (__detail::is_constant_evaluated() == false)
+			{
+				__detail::vector_change_case<true>(reinterpret_cast<char*>(out), reinterpret_cast<const char*>(in), count);
+				return;
+			}
+		}
+		__detail::scalar_change_case<true>(out, in, count);
+	}
+
+	// Number of leading units that are plain ASCII (< 0x80), works on 1, 2 and 4 byte code units
+	template <typename char_t>
+	[[nodiscard]] constexpr size_t ascii_prefix(const char_t* str, size_t count) noexcept
+	{
+		if constexpr (sizeof(char_t) == 1 || sizeof(char_t) == 2 || sizeof(char_t) == 4)
+		{
+			if (__detail::is_constant_evaluated() == false && count >= 16 / sizeof(char_t))
+			{	// short inputs go straight to the scalar twin
+				return __detail::vector_ascii_prefix(str, count);
+			}
+		}
+		return __detail::scalar_ascii_prefix(str, count);
+	}
+}
@@ -49,7 +49,7 @@ namespace cxpr
 		{
 			entry_t search = { key, {} };
 			auto found = cxpr::lower_bound(std::begin(entries), std::end(entries), search);
-			if (found->first == key)
+			if (found != std::end(entries) && found->first == key)
 			{
 				return std::make_pair(true, &found->second);
 			}
@@ -60,11 +60,19 @@ namespace cxpr
 			}
 		}
 
+		// literal keys (see literal.h) look up their hash_invariant value, which is fixed during compile
+		template <typename literal_t, typename map_key_t = key_t,
+			std::enable_if_t<is_literal_v<literal_t> && std::is_same_v<map_key_t, cxpr::hash_t>, int> = 0>
+		[[nodiscard]] constexpr decltype(auto) get_entry(literal_t) const noexcept
+		{
+			return get_entry<literal_t::hash>();
+		}
+
 		[[nodiscard]] constexpr decltype(auto) get_entry(key_t key) const noexcept
 		{
 			entry_t search = { key, {} };
 			auto found = cxpr::lower_bound(std::begin(entries), std::end(entries), search);
-			if (found->first == key)
+			if (found != std::end(entries) && found->first == key)
 			{
 				return std::make_pair(true, &found->second);
 			}
@@ -92,7 +100,7 @@ namespace cxpr
 		{
 			entry_t search = { k, {} };
 			auto found = cxpr::lower_bound(std::begin(entries), std::end(entries), search);
-			if (found->first == k)
+			if (found != std::end(entries) && found->first == k)
 			{
 				return found;
 			}
@@ -0,0 +1,215 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Dense id handed out by string_interner/literal_registry. Once interned, comparing and hashing strings
+	// is just integer work
+	struct interned_id
+	{
+		uint32_t value = 0;
+
+		[[nodiscard]] constexpr cxpr::hash_t hash() const noexcept { return value; }
+		[[nodiscard]] constexpr bool operator==(interned_id other) const noexcept { return value == other.value; }
+		[[nodiscard]] constexpr bool operator!=(interned_id other) const noexcept { return value != other.value; }
+		[[nodiscard]] constexpr bool operator<(interned_id other)  const noexcept { return value < other.value; }
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Compile-time list of string literals with pre-assigned ids (their position in the list). Lookups go
+	// through a static_map keyed on hash_invariant, so a literal's id can be resolved during compile:
+	//
+	//	 constexpr auto tags = cxpr::make_literal_registry({ "host", "user-agent", "accept" });
+	//	 constexpr auto accept_id = tags.id_of("accept");					// compile error if missing
+	//	 constexpr auto entry = tags.get_entry<cxpr::hash_invariant("host")>();	// if constexpr friendly
+	//
+	// Two literals that hash the same (including ones only differing by case) fail to compile
+	template <size_t n>
+	class literal_registry
+	{
+	public:
+		using map_t = static_map<cxpr::hash_t, interned_id, n>;
+
+		constexpr literal_registry(const std::string_view(&in)[n])
+			: literals{}, ids(build_entries(in), cxpr::less{})
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				literals[i] = in[i];
+			}
+
+			for (size_t i = 1; i < n; i++)
+			{
+				if ((ids.begin() + i - 1)->first == (ids.begin() + i)->first)
+				{
+					throw std::logic_error("literal_registry hash collision, literals must hash uniquely");
+				}
+			}
+		}
+
+		constexpr size_t size() const noexcept { return n; }
+		constexpr std::string_view str(interned_id id) const noexcept { return literals[id.value]; }
+
+		// Returns { true, id } if the string is one of the registered literals
+		[[nodiscard]] constexpr std::pair<bool, interned_id> get_entry(std::string_view in) const noexcept
+		{
+			const auto found = ids.get_entry(hash_invariant(in));
+			if (found.first && literals[found.second->value] == in)
+			{
+				return std::make_pair(true, *found.second);
+			}
+
+			return std::make_pair(false, interned_id{});
+		}
+
+		template <cxpr::hash_t key>
+		[[nodiscard]] constexpr decltype(auto) get_entry() const noexcept
+		{
+			return ids.template get_entry<key>();
+		}
+
+		// Throws (so fails to compile in a constant expression) if the literal isn't registered
+		[[nodiscard]] constexpr interned_id id_of(std::string_view in) const
+		{
+			const auto found = get_entry(in);
+			if (found.first == false)
+			{
+				throw std::runtime_error("literal does not exist in cxpr::literal_registry");
+			}
+
+			return found.second;
+		}
+
+	private:
+		std::array<std::string_view, n> literals;
+		map_t ids;
+
+		static constexpr std::array<static_pair<cxpr::hash_t, interned_id>, n> build_entries(const std::string_view(&in)[n])
+		{
+			std::array<static_pair<cxpr::hash_t, interned_id>, n> entries{};
+			for (size_t i = 0; i < n; i++)
+			{
+				entries[i] = static_pair<cxpr::hash_t, interned_id>(hash_invariant(in[i]), interned_id{ static_cast<uint32_t>(i) });
+			}
+			return entries;
+		}
+	};
+
+	template <size_t n>
+	constexpr decltype(auto) make_literal_registry(const std::string_view(&in)[n])
+	{
+		return literal_registry<n>(in);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Maps strings to dense 32 bit ids. Storage is fixed at max_strings entries of up to max_length - 1
+	// characters, so nothing moves once published and lookups never lock: an open-addressed table of atomic
+	// slots is probed and each slot is published with a release store after its entry is written. Interning
+	// a new string takes a mutex. Strings that are too long or an interner that is full throw.
+	// When built from a literal_registry, the registry's literals are interned first so their ids match
+	template <size_t max_strings, size_t max_length = 64>
+	class string_interner
+	{
+	public:
+		using string_t = fixed_string<max_length, no_transform, overrun_behavior_throw>;
+		static constexpr size_t slot_count = cxpr::round_pow_2_v<max_strings * 2>;
+		static constexpr size_t slot_mask = slot_count - 1;
+
+		string_interner() noexcept = default;
+
+		template <size_t n>
+		explicit string_interner(const literal_registry<n>& registry)
+		{
+			static_assert(n <= max_strings, "registry has more literals than the interner can hold");
+			for (uint32_t i = 0; i < n; i++)
+			{
+				intern(registry.str(interned_id{ i }));
+			}
+		}
+
+		string_interner(const string_interner&) = delete;
+		string_interner& operator=(const string_interner&) = delete;
+
+		// Lock-free, returns { true, id } if the string has been interned
+		[[nodiscard]] std::pair<bool, interned_id> find(std::string_view in) const noexcept
+		{
+			return find(in, hash_invariant(in));
+		}
+
+		// Returns the id for the string, adding it if needed. Lock-free if it's already present
+		interned_id intern(std::string_view in)
+		{
+			const auto hash = hash_invariant(in);
+			const auto found = find(in, hash);
+			if (found.first)
+			{
+				return found.second;
+			}
+
+			std::lock_guard<std::mutex> lock(writeLock);
+			const auto raced = find(in, hash); // someone might have added it while we waited
+			if (raced.first)
+			{
+				return raced.second;
+			}
+
+			const auto id = count.load(std::memory_order_relaxed);
+			if (id >= max_strings)
+			{
+				throw std::runtime_error("cxpr::string_interner is full");
+			}
+			if (in.size() > string_t::max_sz)
+			{
+				throw std::runtime_error("string too long for cxpr::string_interner, aborting intern");
+			}
+
+			entries[id].value = string_t(in);
+			entries[id].hash = hash;
+			count.store(id + 1, std::memory_order_release);
+
+			size_t idx = hash & slot_mask;
+			while (slots[idx].load(std::memory_order_relaxed) != 0)
+			{
+				idx = (idx + 1) & slot_mask;
+			}
+			slots[idx].store(id + 1, std::memory_order_release); // publish
+
+			return interned_id{ id };
+		}
+
+		[[nodiscard]] std::string_view str(interned_id id) const noexcept { return entries[id.value].value; }
+		[[nodiscard]] size_t size() const noexcept { return count.load(std::memory_order_acquire); }
+		[[nodiscard]] constexpr size_t capacity() const noexcept { return max_strings; }
+
+	private:
+		struct entry_t
+		{
+			cxpr::hash_t hash = 0;
+			string_t value;
+		};
+
+		std::array<std::atomic<uint32_t>, slot_count> slots{}; // id + 1, 0 is empty
+		std::array<entry_t, max_strings> entries{};
+		std::atomic<uint32_t> count{ 0 };
+		std::mutex writeLock;
+
+		std::pair<bool, interned_id> find(std::string_view in, cxpr::hash_t hash) const noexcept
+		{
+			size_t idx = hash & slot_mask;
+			for (auto slot = slots[idx].load(std::memory_order_acquire); slot != 0;
+				slot = slots[idx].load(std::memory_order_acquire))
+			{
+				const auto& entry = entries[slot - 1];
+				if (entry.hash == hash && entry.value == in)
+				{
+					return std::make_pair(true, interned_id{ slot - 1 });
+				}
+				idx = (idx + 1) & slot_mask;
+			}
+
+			return std::make_pair(false, interned_id{});
+		}
+	};
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		// Character type behind anything that can be viewed as a string (literals, std::string, string_view, fixed_string)
+		template <typename source_t>
+		using source_char_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::data(std::declval<const source_t&>()))>>;
+
+		template <typename char_t>
+		constexpr size_t find_delimiter(std::basic_string_view<char_t> in, char_t delimiter) noexcept
+		{
+			return cxpr::find_index(in.data(), in.size(), delimiter);
+		}
+
+		template <typename char_t>
+		constexpr size_t find_delimiter(std::basic_string_view<char_t> in, std::basic_string_view<char_t> delimiter) noexcept
+		{
+			return cxpr::find_index(in.data(), in.size(), delimiter.data(), delimiter.size());
+		}
+
+		template <typename char_t>
+		constexpr size_t delimiter_size(char_t) noexcept { return 1; }
+
+		template <typename char_t>
+		constexpr size_t delimiter_size(std::basic_string_view<char_t> delimiter) noexcept { return delimiter.size(); }
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Walks a string and hands out views of the text between delimiters, nothing is copied or allocated.
+	// The views point into the source so it has to outlive them. Single character delimiters are located
+	// with the vectorized cxpr::find_index scan, delimiter_t can also be a basic_string_view for multi-character
+	// delimiters. With skip_empty set, runs of delimiters are collapsed (ie "a,,b" -> "a", "b")
+	template <typename char_t, typename delimiter_t = char_t>
+	class basic_splitter
+	{
+	public:
+		using view_t = std::basic_string_view<char_t>;
+		using my_t = basic_splitter<char_t, delimiter_t>;
+
+		constexpr basic_splitter(view_t source, delimiter_t delim, bool skipEmpty = false) noexcept
+			: remaining(source), delimiter(delim), skip_empty(skipEmpty), finished(false)
+		{
+			if (__detail::delimiter_size<char_t>(delimiter) == 0)
+			{	// nothing to split on, the whole source is one token
+				delimiterStep = remaining.size() + 1;
+			}
+			else
+			{
+				delimiterStep = __detail::delimiter_size<char_t>(delimiter);
+			}
+		}
+
+		// Stores the next token in 'token', returns false once the source is exhausted
+		constexpr bool next(view_t& token) noexcept
+		{
+			while (finished == false)
+			{
+				const size_t found = (delimiterStep > remaining.size())
+					? remaining.size() : __detail::find_delimiter<char_t>(remaining, delimiter);
+
+				token = remaining.substr(0, found);
+				if (found == remaining.size())
+				{
+					finished = true;
+				}
+				else
+				{
+					remaining.remove_prefix(found + delimiterStep);
+				}
+
+				if (skip_empty == false || token.empty() == false)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = view_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const view_t*;
+			using reference = const view_t&;
+
+			constexpr iterator() noexcept : state(view_t{}, delimiter_t{}), current{}, done(true) {}
+			constexpr explicit iterator(const my_t& splitter) noexcept : state(splitter), current{}, done(false)
+			{
+				done = state.next(current) == false;
+			}
+
+			constexpr reference operator*()  const noexcept { return current; }
+			constexpr pointer	operator->() const noexcept { return &current; }
+			constexpr iterator& operator++() noexcept
+			{
+				done = state.next(current) == false;
+				return *this;
+			}
+			constexpr iterator operator++(int) noexcept
+			{
+				iterator prev = *this;
+				++(*this);
+				return prev;
+			}
+
+			// only end-ness is compared, iterators are meant for a single pass in range-for
+			constexpr bool operator==(const iterator& other) const noexcept { return done == other.done; }
+			constexpr bool operator!=(const iterator& other) const noexcept { return done != other.done; }
+
+		private:
+			my_t state;
+			view_t current;
+			bool done;
+		};
+
+		constexpr iterator begin() const noexcept { return iterator(*this); }
+		constexpr iterator end()   const noexcept { return iterator(); }
+
+	private:
+		view_t remaining;
+		delimiter_t delimiter;
+		size_t delimiterStep = 1;
+		bool skip_empty;
+		bool finished;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Creates a splitter over any string-like source. Delimiters that are single characters are scanned for
+	// directly, anything else is treated as a multi-character delimiter
+	//	 for (auto field : cxpr::make_splitter(line, '|')) {...}
+	template <typename source_t, typename delimiter_t>
+	constexpr decltype(auto) make_splitter(const source_t& source, const delimiter_t& delimiter, bool skipEmpty = false) noexcept
+	{
+		using char_t = __detail::source_char_t<source_t>;
+		using view_t = std::basic_string_view<char_t>;
+		if constexpr (std::is_same_v<delimiter_t, char_t>)
+		{
+			return basic_splitter<char_t, char_t>(view_t(source), delimiter, skipEmpty);
+		}
+		else
+		{
+			return basic_splitter<char_t, view_t>(view_t(source), view_t(delimiter), skipEmpty);
+		}
+	}
+
+	namespace __detail
+	{
+		template <size_t max_tokens, typename overrun_behavior, typename splitter_t>
+		constexpr decltype(auto) collect_tokens(splitter_t splitter)
+		{
+			using view_t = typename splitter_t::view_t;
+			fixed_vector<view_t, max_tokens> ret{};
+			view_t token{};
+			while (splitter.next(token))
+			{
+				if (ret.saturated())
+				{
+					if constexpr (std::is_same_v<overrun_behavior, overrun_behavior_throw>)
+					{
+						throw std::runtime_error("too many tokens for split, aborting");
+					}
+					break;
+				}
+				ret.push_back(token);
+			}
+			return ret;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Splits the source into at most max_tokens views, empty fields are kept (ie "a,,b" -> "a", "", "b").
+	// Extra fields are dropped or throw depending on overrun_behavior. Usable at compile-time:
+	//	 constexpr auto fields = cxpr::split<4>("id,name,value", ',');
+	template <size_t max_tokens, typename overrun_behavior = overrun_behavior_trunc, typename source_t, typename delimiter_t>
+	constexpr decltype(auto) split(const source_t& source, const delimiter_t& delimiter)
+	{
+		return __detail::collect_tokens<max_tokens, overrun_behavior>(make_splitter(source, delimiter, false));
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Same as split but skips empty tokens, for whitespace-style separators
+	template <size_t max_tokens, typename overrun_behavior = overrun_behavior_trunc, typename source_t, typename delimiter_t>
+	constexpr decltype(auto) tokenize(const source_t& source, const delimiter_t& delimiter)
+	{
+		return __detail::collect_tokens<max_tokens, overrun_behavior>(make_splitter(source, delimiter, true));
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// ASCII case-insensitive comparisons over any string-like arguments. Both sides are folded a block at
+	// a time while comparing, no lowercased copies are made
+	//	 if (cxpr::iequals(header.name, "Content-Length")) {...}
+	template <typename l_t, typename r_t>
+	[[nodiscard]] constexpr bool iequals(const l_t& l, const r_t& r) noexcept
+	{
+		using view_t = std::basic_string_view<__detail::source_char_t<l_t>>;
+		const view_t lv(l);
+		const view_t rv(r);
+		return lv.size() == rv.size() && cxpr::imismatch_index(lv.data(), rv.data(), lv.size()) == lv.size();
+	}
+
+	// <0, 0, >0 like std::string::compare, ordering the lowercased strings
+	template <typename l_t, typename r_t>
+	[[nodiscard]] constexpr int icompare(const l_t& l, const r_t& r) noexcept
+	{
+		using view_t = std::basic_string_view<__detail::source_char_t<l_t>>;
+		using traits_t = typename view_t::traits_type;
+		const view_t lv(l);
+		const view_t rv(r);
+		const size_t common = std::min(lv.size(), rv.size());
+		const size_t idx = cxpr::imismatch_index(lv.data(), rv.data(), common);
+		if (idx < common)
+		{
+			return traits_t::lt(cx_tolower(lv[idx]), cx_tolower(rv[idx])) ? -1 : 1;
+		}
+
+		return (lv.size() < rv.size()) ? -1 : (lv.size() > rv.size() ? 1 : 0);
+	}
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <stdexcept>
 #include <type_traits>
 #include <tuple>
 #include <utility>
@@ -31,23 +33,22 @@ namespace cxpr
 		return folder_t<params_t...>{}();
 	}
 
-	/////////////////////////////////////////////////////////////////////////
-	// visit_tuple
-	// Calls functor_t with each tuple member (for each over the tuple)
-	template<typename functor_t, typename tuple_t, std::size_t N>
-	constexpr decltype(auto) visit_tuple(functor_t fun, tuple_t&& tt)
+	namespace __detail
 	{
-		fun(std::forward<decltype(std::get<N>(tt))>(std::get<N>(tt)));
-		if constexpr (N < (std::tuple_size_v<std::decay_t<tuple_t>> -1))
+		template<typename functor_t, typename tuple_t, std::size_t ... idx>
+		constexpr void _visit_tuple(functor_t& fun, tuple_t& tt, std::index_sequence<idx...>)
 		{
-			visit_tuple<functor_t, tuple_t, N + 1>(fun, tt);
+			(static_cast<void>(fun(std::get<idx>(tt))), ...);
 		}
 	}
 
+	/////////////////////////////////////////////////////////////////////////
+	// visit_tuple
+	// Calls functor_t with each tuple member (for each over the tuple), in order
 	template<typename functor_t, typename tuple_t>
-	constexpr decltype(auto) visit_tuple(functor_t fun, tuple_t&& tt)
+	constexpr void visit_tuple(functor_t fun, tuple_t&& tt)
 	{
-		return visit_tuple<functor_t, tuple_t, 0>(fun, tt);
+		__detail::_visit_tuple(fun, tt, std::make_index_sequence<std::tuple_size_v<std::decay_t<tuple_t>>>{});
 	}
 
 	namespace __detail
@@ -86,100 +87,340 @@ namespace cxpr
 
 	namespace __detail
 	{
-		template<typename functor_t, typename tuple_t, typename ret_t, std::size_t N>
-		constexpr decltype(auto) _visit_tuple_capture(functor_t fun, tuple_t&& tt, ret_t&& ret)
+		// Braced initialization evaluates the calls in order
+		template<typename functor_t, typename tuple_t, std::size_t ... idx>
+		constexpr decltype(auto) _visit_tuple_capture(functor_t& fun, tuple_t& tt, std::index_sequence<idx...>)
 		{
-			auto&& result = fun(std::forward<decltype(std::get<N>(tt))>(std::get<N>(tt)));
-			auto wrapped = std::tuple_cat(std::move(ret), std::tie(result));
-			if constexpr (N < (std::tuple_size_v<std::decay_t<tuple_t>> -1))
-			{
-				return _visit_tuple_capture<functor_t, tuple_t, decltype(wrapped), N + 1>(fun, tt, std::move(wrapped));
-			}
-			else
-			{
-				return wrapped;
-			}
+			return std::tuple<decltype(fun(std::get<idx>(tt)))...>{ fun(std::get<idx>(tt))... };
 		}
 	}
 
 	//////////////////////////////////////////////////////////////////////////
 	// visit_tuple_capture
-	// Visits every member of the tuple and returns a tuple representing the result of each invocation
+	// Visits every member of the tuple and returns a tuple representing the result of each invocation.
+	// Results are held by value, unless the functor returns a reference
 	template<typename functor_t, typename tuple_t>
 	constexpr decltype(auto) visit_tuple_capture(functor_t fun, tuple_t&& tt)
 	{
-		std::tuple<> ret = {};
-		return __detail::_visit_tuple_capture<functor_t, tuple_t, decltype(ret), 0>(fun, tt, std::move(ret));
+		return __detail::_visit_tuple_capture(fun, tt, std::make_index_sequence<std::tuple_size_v<std::decay_t<tuple_t>>>{});
 	}
 
-	struct starter_marker {};
-	using type_collector = typeset<starter_marker>;
-
-	template<template<typename ...> class typeset_t,
-		template<typename ...> class right_t,
-		typename ... collapsed_ts,
-		typename ... right_ts>
-		decltype(auto) operator<<(const typeset_t<collapsed_ts...>, const right_t<right_ts...>*)
+	namespace __detail
 	{
-		if constexpr (std::is_same_v<typeset_t<collapsed_ts...>, type_collector>)
-		{	// collapsed_ts is just the marker type, ignore it and just take the right side
-			return typeset<right_ts...>{};
+		// Same type for every call keeps references, otherwise the results decay to their common type
+		template <typename first_t, typename ... results_t>
+		struct visit_result
+		{
+			using type = std::conditional_t<(std::is_same_v<first_t, results_t> && ...),
+				first_t, std::common_type_t<first_t, results_t...>>;
+		};
+
+		template <typename functor_t, typename tuple_t>
+		struct tuple_at_table
+		{
+			static constexpr std::size_t size = std::tuple_size_v<std::decay_t<tuple_t>>;
+
+			template <std::size_t ... idx>
+			static auto table_result(std::index_sequence<idx...>)
+				-> typename visit_result<decltype(std::declval<functor_t&>()(std::get<idx>(std::declval<tuple_t&>())))...>::type;
+
+			using result_t = decltype(table_result(std::make_index_sequence<size>{}));
+			using entry_t = result_t(*)(functor_t& fun, tuple_t& tt);
+
+			template <std::size_t idx>
+			static constexpr result_t call(functor_t& fun, tuple_t& tt)
+			{
+				return static_cast<result_t>(fun(std::get<idx>(tt)));
+			}
+
+			template <std::size_t ... idx>
+			static constexpr std::array<entry_t, size> make_table(std::index_sequence<idx...>) noexcept
+			{
+				return { &call<idx>... };
+			}
+
+			static constexpr std::array<entry_t, size> table = make_table(std::make_index_sequence<size>{});
+		};
+
+		// Tasks are submitted in order, so if the executor throws, the ones already running (which still use
+		// tt and fun) are waited for before the exception leaves
+		template <typename functor_t, typename tuple_t, std::size_t ... idx>
+		void _parallel_visit_tuple(functor_t& fun, tuple_t& tt, std::index_sequence<idx...>)
+		{
+			std::tuple<std::optional<decltype(fun(std::get<idx>(tt)))>...> pending;
+			try
+			{
+				(static_cast<void>(std::get<idx>(pending).emplace(fun(std::get<idx>(tt)))), ...);
+			}
+			catch (...)
+			{
+				((std::get<idx>(pending).has_value() ? std::get<idx>(pending)->wait() : void()), ...);
+				throw;
+			}
+			(std::get<idx>(pending)->wait(), ...);
+			(static_cast<void>(std::get<idx>(pending)->get()), ...); // rethrows the first failure, after all are done
 		}
-		else
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// tuple_at
+	// Calls functor_t with the tuple member at a runtime index through a table of function pointers, one per
+	// member. Returns the common type of every call (references are kept when all calls agree)
+	//	 cxpr::tuple_at(shards, shard_of(key), [&](auto& shard) { shard.insert(key); });
+	// Throws std::out_of_range if idx is past the end of the tuple
+	template<typename tuple_t, typename functor_t>
+	constexpr decltype(auto) tuple_at(tuple_t&& tt, std::size_t idx, functor_t fun)
+	{
+		using table_t = __detail::tuple_at_table<functor_t, std::remove_reference_t<tuple_t>>;
+		static_assert(table_t::size > 0, "tuple_at needs a non-empty tuple");
+		if (idx >= table_t::size)
 		{
-			// we're rolling now, take both sides 
-			return typeset<collapsed_ts..., right_ts...>{};
+			throw std::out_of_range("tuple_at index is out of range");
 		}
+		return table_t::table[idx](fun, tt);
 	}
 
 	//////////////////////////////////////////////////////////////////////////
+	// parallel_visit_tuple
+	// Hands one task per tuple member to executor and waits for all of them. The executor takes a nullary
+	// callable, starts it and returns something with wait() and get(), like std::future:
+	//	 cxpr::parallel_visit_tuple([](auto& shard) { shard.flush(); }, shards,
+	//		 [](auto task) { return std::async(std::launch::async, task); });
+	// Tasks may run concurrently, so functor_t must be safe to call from several threads at once. The first
+	// exception thrown by a task is rethrown once every task has finished, and one thrown by the executor
+	// once every task it already started has
+	template<typename functor_t, typename tuple_t, typename executor_t>
+	void parallel_visit_tuple(functor_t fun, tuple_t&& tt, executor_t&& executor)
+	{
+		auto submit = [&](auto& member)
+		{
+			return executor([&fun, &member]() { fun(member); });
+		};
+		__detail::_parallel_visit_tuple(submit, tt, std::make_index_sequence<std::tuple_size_v<std::decay_t<tuple_t>>>{});
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Typeset algorithms. Every one of them takes a typeset (or tuple, or any template<typename...>) and
+	// gives back a typeset. They avoid recursing once per type: lookups go through a class that inherits one
+	// base per type, so the compiler resolves them by overload deduction, and the result of filter,
+	// sort and concat is picked out of the input through constexpr index arrays.
 
 	namespace __detail
 	{
-		template <typename ... Ts>
-		struct unique_types;
+		template <size_t idx, typename T>
+		struct indexed_type
+		{
+			using type = T;
+		};
+
+		template <typename seq_t, typename ... types_t>
+		struct indexed_types;
+
+		template <size_t ... idx, typename ... types_t>
+		struct indexed_types<std::index_sequence<idx...>, types_t...> : indexed_type<idx, types_t>... {};
 
-		template <typename curr_t, typename ... Ts>
-		struct unique_types<curr_t, Ts...>
+		template <size_t idx, typename T>
+		indexed_type<idx, T> select_indexed(const indexed_type<idx, T>*);
+
+		template <size_t idx, typename ... types_t>
+		using nth_type_t = typename decltype(select_indexed<idx>(
+			static_cast<indexed_types<std::index_sequence_for<types_t...>, types_t...>*>(nullptr)))::type;
+
+		template <typename set_t>
+		struct typeset_unpack;
+
+		template <template <typename ...> class wrapper_t, typename ... types_t>
+		struct typeset_unpack<wrapper_t<types_t...>>
 		{
-			template <typename ... out_ts>
-			static constexpr decltype(auto) iterate(typeset<out_ts...>* output = nullptr)
+			static constexpr size_t size = sizeof...(types_t);
+
+			template <size_t idx>
+			using at = nth_type_t<idx, types_t...>;
+
+			template <template <typename ...> class target_t>
+			using apply = target_t<types_t...>;
+		};
+
+		// The first 'count' entries of 'indices' are the positions to keep, in output order
+		template <size_t n>
+		struct type_picks
+		{
+			std::array<size_t, n> indices{};
+			size_t count = 0;
+		};
+
+		template <size_t n>
+		constexpr type_picks<n> picks_where(const std::array<bool, n>& keep) noexcept
+		{
+			type_picks<n> out;
+			for (size_t i = 0; i < n; i++)
 			{
-				// check if any types are the same as the current type, if so skip it 
-				constexpr bool type_exists = (... || std::is_same_v<std::decay<curr_t>, std::decay<out_ts>>);
-				if constexpr (type_exists == false)
+				if (keep[i])
 				{
-					return unique_types<Ts...>::iterate((typeset<out_ts..., curr_t>*)0);
+					out.indices[out.count++] = i;
 				}
-				else
+			}
+			return out;
+		}
+
+		// Positions sorted by descending key, equal keys keep their order
+		template <size_t n>
+		constexpr std::array<size_t, n> stable_order_desc(const std::array<size_t, n>& keys) noexcept
+		{
+			std::array<size_t, n> order{};
+			for (size_t i = 0; i < n; i++)
+			{
+				size_t pos = i;
+				for (; pos > 0 && keys[order[pos - 1]] < keys[i]; pos--)
 				{
-					return unique_types<Ts...>::iterate((typeset<out_ts...>*)0);
+					order[pos] = order[pos - 1];
 				}
+				order[pos] = i;
 			}
+			return order;
+		}
+
+		// plan_t::picks says which types of set_t make up the result
+		template <typename plan_t, typename set_t, size_t ... i>
+		auto pick_types(std::index_sequence<i...>) -> typeset<typename typeset_unpack<set_t>::template at<plan_t::picks.indices[i]>...>;
+
+		template <typename plan_t, typename set_t>
+		using picked_types_t = decltype(pick_types<plan_t, set_t>(std::make_index_sequence<plan_t::picks.count>{}));
 
-			static constexpr decltype(auto) iterate()
+		template <typename set_t, template <typename> class pred_t, bool expected>
+		struct filter_plan;
+
+		template <template <typename ...> class wrapper_t, typename ... types_t, template <typename> class pred_t, bool expected>
+		struct filter_plan<wrapper_t<types_t...>, pred_t, expected>
+		{
+			static constexpr auto picks = picks_where(std::array<bool, sizeof...(types_t)>{ (bool(pred_t<types_t>::value) == expected)... });
+		};
+
+		template <typename set_t>
+		struct size_order_plan;
+
+		template <template <typename ...> class wrapper_t, typename ... types_t>
+		struct size_order_plan<wrapper_t<types_t...>>
+		{
+			static constexpr auto picks = type_picks<sizeof...(types_t)>{
+				stable_order_desc(std::array<size_t, sizeof...(types_t)>{ sizeof(types_t)... }), sizeof...(types_t) };
+		};
+
+		// Output position i is element elements[i] of set sets[i]
+		template <size_t ... sizes>
+		struct concat_plan
+		{
+			static constexpr size_t total = (sizes + ... + 0);
+
+			static constexpr auto make() noexcept
 			{
-				return unique_types<Ts...>::iterate((typeset<curr_t>*)0);
+				constexpr size_t counts[] = { sizes..., 0 };
+				std::pair<std::array<size_t, total>, std::array<size_t, total>> out{};
+				size_t pos = 0;
+				for (size_t set = 0; set < sizeof...(sizes); set++)
+				{
+					for (size_t elem = 0; elem < counts[set]; elem++, pos++)
+					{
+						out.first[pos] = set;
+						out.second[pos] = elem;
+					}
+				}
+				return out;
 			}
+
+			static constexpr auto layout = make();
+		};
+
+		template <typename plan_t, typename ... sets_t, size_t ... i>
+		auto concat_types(std::index_sequence<i...>)
+			-> typeset<typename typeset_unpack<nth_type_t<plan_t::layout.first[i], sets_t...>>::template at<plan_t::layout.second[i]>...>;
+
+		// Set-inheritance accumulator: a type is only added when it isn't a base yet
+		template <typename T>
+		struct type_tag {};
+
+		template <typename ... types_t>
+		struct unique_accumulator : type_tag<types_t>...
+		{
+			using type = typeset<types_t...>;
 		};
 
-		template <>
-		struct unique_types<>
+		template <typename ... types_t, typename T>
+		auto operator+(unique_accumulator<types_t...>, type_tag<T>)
+			-> std::conditional_t<std::is_base_of_v<type_tag<T>, unique_accumulator<types_t...>>,
+				unique_accumulator<types_t...>, unique_accumulator<types_t..., T>>;
+
+		template <typename set_t>
+		struct unique_plan;
+
+		template <template <typename ...> class wrapper_t, typename ... types_t>
+		struct unique_plan<wrapper_t<types_t...>>
 		{
-			// end of expansion, return the wrapped types
-			template <typename ... out_ts>
-			static constexpr decltype(auto) iterate(typeset<out_ts...>* output = nullptr)
+			using type = typename decltype((std::declval<unique_accumulator<>>() + ... + std::declval<type_tag<types_t>>()))::type;
+		};
+
+		template <typename T, typename set_t>
+		struct index_of_plan;
+
+		template <typename T, template <typename ...> class wrapper_t, typename ... types_t>
+		struct index_of_plan<T, wrapper_t<types_t...>>
+		{
+			static constexpr size_t value()
 			{
-				return typeset<out_ts...>();
+				constexpr bool matches[] = { std::is_same_v<T, types_t>..., false };
+				for (size_t i = 0; i < sizeof...(types_t); i++)
+				{
+					if (matches[i])
+					{
+						return i;
+					}
+				}
+				return sizeof...(types_t);
 			}
 		};
+	}
 
-		template<template<typename ...> class tuple_t, typename ... types_t>
-		constexpr decltype(auto) tuple_unique(const tuple_t<types_t...>* tt = nullptr)
-		{
-			return unique_types<types_t...>::iterate();
-		}
+	// Type at position idx
+	template <size_t idx, typename set_t>
+	using typeset_element_t = typename __detail::typeset_unpack<set_t>::template at<idx>;
+
+	// Position of the first type that is exactly T, or the size of the set if there is none
+	template <typename T, typename set_t>
+	constexpr size_t typeset_index_of_v = __detail::index_of_plan<T, set_t>::value();
+
+	template <typename T, typename set_t>
+	constexpr bool typeset_contains_v = typeset_index_of_v<T, set_t> != __detail::typeset_unpack<set_t>::size;
 
+	// Types for which pred_t<T>::value is true, in order
+	//	 cxpr::typeset_filter_t<messages_t, std::is_trivially_copyable>
+	template <typename set_t, template <typename> class pred_t>
+	using typeset_filter_t = __detail::picked_types_t<__detail::filter_plan<set_t, pred_t, true>, set_t>;
+
+	// Splits a set into the types that match pred_t and the rest, both in order
+	template <typename set_t, template <typename> class pred_t>
+	struct typeset_partition
+	{
+		using matching = typeset_filter_t<set_t, pred_t>;
+		using rest = __detail::picked_types_t<__detail::filter_plan<set_t, pred_t, false>, set_t>;
+	};
+
+	// First occurrence of every type, compared exactly (see unique_types_t for a decaying version)
+	template <typename set_t>
+	using typeset_unique_t = typename __detail::unique_plan<set_t>::type;
+
+	// Largest type first, types of the same size keep their order
+	template <typename set_t>
+	using typeset_sort_by_size_t = __detail::picked_types_t<__detail::size_order_plan<set_t>, set_t>;
+
+	// All the types of every set, in order
+	template <typename ... sets_t>
+	using typeset_concat_t = decltype(__detail::concat_types<__detail::concat_plan<__detail::typeset_unpack<sets_t>::size...>, sets_t...>(
+		std::make_index_sequence<__detail::concat_plan<__detail::typeset_unpack<sets_t>::size...>::total>{}));
+
+	//////////////////////////////////////////////////////////////////////////
+
+	namespace __detail
+	{
 		template<template<typename ...> class wrapper_t, typename ... types_t>
 		constexpr decltype(auto) pack_size(const wrapper_t<types_t...>* tt = nullptr)
 		{
@@ -193,32 +434,18 @@ namespace cxpr
 		{
 			return typeset<mutator_t<types_t>...>{};
 		}
-
-
-		
-
-		template <typename ... wrapped_types_t>
-		constexpr decltype(auto) collapse_types(wrapped_types_t*... types)
-		{
-			return (type_collector{} << ... << types);
-		}
-
-		template<template<typename ...> class wrapper_t, typename ... types_t>
-		constexpr decltype(auto) collapse_nested_tuple(const wrapper_t<types_t...>* tt = nullptr)
-		{
-			return decltype(collapse_types((types_t*)(0)...)){};
-		}
 	}
 
 	// The following decomposes a pack of types into the unique components (aka removes duplicate types).
-	// The implementation decays types before comparison, so int& and int will be discarded to just int
+	// The implementation decays types before comparison, so int& and int will be discarded to just int.
+	// Note the result holds the decayed types; older versions kept int& and int apart and returned them as is
 	template <typename ... types_t>
-	using unique_types_t = decltype(__detail::unique_types<types_t...>::iterate());
+	using unique_types_t = typeset_unique_t<typeset<std::decay_t<types_t>...>>;
 
 	// The following decompose a tuple into it's unique components (aka removes duplicate types).
 	// The implementation decays types before comparison, so int& and int will be discarded to just int
 	template<typename tuple_t>
-	using tuple_unique_t = decltype(__detail::tuple_unique((tuple_t*)0));
+	using tuple_unique_t = typename __detail::typeset_unpack<tuple_t>::template apply<unique_types_t>;
 
 	// The following decompose a tuple into it's unique components (aka removes duplicate types).
 	// The implementation decays types before comparison, so int& and int will be discarded to just int
@@ -228,15 +455,37 @@ namespace cxpr
 	// collapses a param pack full of tuples to one typeset
 	// ie: tuple<int, double>, tuple<string, char> -> tuple<int, double, string, char>
 	template<typename ... tuple_t>
-	using collapse_tuples_t = decltype(__detail::collapse_types<tuple_t...>((tuple_t*)(0)...));
+	using collapse_tuples_t = typeset_concat_t<tuple_t...>;
 
 	// collapses a tuple full of tuples to one typeset
 	// ie: tuple<tuple<int, double>, tuple<string, char>> -> tuple<int, double, string, char>
 	template<typename tuple_t>
-	using collapse_nested_tuple_t = decltype(__detail::collapse_nested_tuple((tuple_t*)(0)));
+	using collapse_nested_tuple_t = typename __detail::typeset_unpack<tuple_t>::template apply<typeset_concat_t>;
+
+	// Deprecated left fold collector, kept for existing (type_collector{} << ... << (sets_t*)0) folds.
+	// The marker is dropped by the first fold step, every step forwards to typeset_concat_t
+	struct starter_marker {};
+	using type_collector [[deprecated("use typeset_concat_t or collapse_tuples_t")]] = typeset<starter_marker>;
+
+	template<template<typename ...> class typeset_t,
+		template<typename ...> class right_t,
+		typename ... collapsed_ts,
+		typename ... right_ts>
+		[[deprecated("use typeset_concat_t or collapse_tuples_t")]]
+		constexpr decltype(auto) operator<<(const typeset_t<collapsed_ts...>, const right_t<right_ts...>*)
+	{
+		if constexpr (std::is_same_v<typeset_t<collapsed_ts...>, typeset<starter_marker>>)
+		{
+			return typeset_concat_t<right_t<right_ts...>>{};
+		}
+		else
+		{
+			return typeset_concat_t<typeset_t<collapsed_ts...>, right_t<right_ts...>>{};
+		}
+	}
 
 	// returns the number of types in the tuple
 	// ie: tuple<tuple<int, double> -> 2
 	template<typename tuple_t>
 	static constexpr size_t param_count_v = __detail::pack_size((tuple_t*)0);
-}
\ No newline at end of file
+}
@@ -26,43 +26,115 @@ namespace cxpr
 			static constexpr const char* data()
 			{
 				// this returns the fully-decorated function name, which will be unique for each type passed in.
-				// ie for double this will be approx: "const char *__cdecl name_hash<double>::hash_data(void)"
+				// ie for double this will be approx:
+				//	 msvc:  "const char *__cdecl cxpr::__detail::compiletime_unique_str<double>::data(void)"
+				//	 gcc:	"static constexpr const char* cxpr::__detail::compiletime_unique_str<obj_t>::data() [with obj_t = double]"
+				//	 clang: "static const char *cxpr::__detail::compiletime_unique_str<double>::data() [obj_t = double]"
+#if defined(_MSC_VER) && !defined(__clang__)
 				return __FUNCSIG__;
+#else
+				return __PRETTY_FUNCTION__;
+#endif
 			}
 
 			static constexpr size_t length = cxpr::cx_strlen(compiletime_unique_str<obj_t>::data());
 		};
+
+		// The type always shows up last in the decorated name, so the text around it is measured once with a
+		// known type and trimmed off
+		template <typename obj_t>
+		constexpr std::string_view bare_type_name() noexcept
+		{
+			constexpr std::string_view probe(compiletime_unique_str<double>::data(), compiletime_unique_str<double>::length);
+			constexpr size_t prefix = probe.rfind("double");
+			constexpr size_t suffix = probe.size() - prefix - std::string_view("double").size();
+
+			constexpr std::string_view full(compiletime_unique_str<obj_t>::data(), compiletime_unique_str<obj_t>::length);
+			return full.substr(prefix, full.size() - prefix - suffix);
+		}
 	}
 
 	template <typename obj_t>
 	constexpr const char* name_hash_v = __detail::compiletime_unique_str<obj_t>::data();
 
+	// Name of the type as the compiler spells it, ie "int" or "std::__cxx11::basic_string<char>" (gcc).
+	// Names aren't unique: gcc spells every lambda of a scope the same ("main()::<lambda(int)>"), and
+	// types of the same name in anonymous namespaces of different translation units match too
+	template <typename obj_t>
+	constexpr std::string_view type_name_v = __detail::bare_type_name<obj_t>();
+
 	//////////////////////////////////////////////////////////////////////////
-	// Struct that computes a run-time hash using the PJW hash algorithm 
-	// (https://en.wikipedia.org/wiki/PJW_hash_function)
-	constexpr size_t hash_typename(const char* s)
+	// 64 bit hash of a type name, see __detail::hash_bytes
+	constexpr hash_t hash_typename(std::string_view name) noexcept
 	{
-		size_t h = 0;
-		size_t high = 0;
-		while (*s)
-		{
-			h = (h << 4) + *s++;
-			high = (h & 0xF0000000);
-			if (high)
-				h ^= high >> 24;
-			h &= ~high;
-		}
-		return h;
+		return __detail::hash_bytes<false>(name.data(), name.size());
 	}
 
-	// Accessor type for the actual hashed value
+	// Accessor type for the actual hashed value. Types are decayed first so int, int& and const int& match
 	template <typename obj_t>
 	struct type_hash
 	{
-		static constexpr hash_t value = hash_typename(name_hash_v<std::decay_t<obj_t>>);
+		static constexpr hash_t value = hash_typename(type_name_v<std::decay_t<obj_t>>);
 	};
 
+	// Only as unique as type_name_v, so two types can share a hash. Anything that tells types apart by it
+	// must check its type set with assert_unique_typehashes, and a check against one known type should
+	// compare something per type instead (ie the address of a static, like fast_any does)
 	template <typename obj_t>
 	static constexpr auto typehash_v = type_hash<obj_t>::value;
-}
 
+	//////////////////////////////////////////////////////////////////////////
+	// Checks that every type in a typeset (or tuple) hashes to a different value, so tables keyed on
+	// typehash_v can't confuse two types. Types that decay to the same type count as a collision
+	//	 static_assert(cxpr::unique_typehashes_v<message_types>, "...");
+	namespace __detail
+	{
+		template <size_t n>
+		constexpr bool all_distinct(const hash_t (&hashes)[n]) noexcept
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				for (size_t j = i + 1; j < n; j++)
+				{
+					if (hashes[i] == hashes[j])
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+	}
+
+	template <typename set_t>
+	struct unique_typehashes;
+
+	template <template <typename ...> class set_t, typename ... types_t>
+	struct unique_typehashes<set_t<types_t...>>
+	{
+		static constexpr bool value = []() constexpr
+		{
+			if constexpr (sizeof...(types_t) == 0)
+			{
+				return true;
+			}
+			else
+			{
+				constexpr hash_t hashes[] = { typehash_v<types_t>... };
+				return __detail::all_distinct(hashes);
+			}
+		}();
+	};
+
+	template <typename set_t>
+	static constexpr bool unique_typehashes_v = unique_typehashes<set_t>::value;
+
+	// Compile error if any two types in the set share a hash, returns true so it can seed a constexpr/static_assert.
+	// This is the guard for every table keyed on typehash_v (type_map, event_bus, poly_collection)
+	template <typename set_t>
+	constexpr bool assert_unique_typehashes() noexcept
+	{
+		static_assert(unique_typehashes_v<set_t>, "typehash_v collision in type set, hash-keyed dispatch would be ambiguous");
+		return true;
+	}
+}
\ No newline at end of file
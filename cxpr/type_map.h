@@ -0,0 +1,181 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace cxpr
+{
+	namespace __detail
+	{
+		// Index of the first type in the pack that decays to T, or the pack size if there is none
+		template <typename T, typename ... types_t>
+		constexpr size_t type_index_of() noexcept
+		{
+			constexpr bool matches[] = { std::is_same_v<std::decay_t<T>, std::decay_t<types_t>>..., false };
+			for (size_t i = 0; i < sizeof...(types_t); i++)
+			{
+				if (matches[i])
+				{
+					return i;
+				}
+			}
+			return sizeof...(types_t);
+		}
+
+		struct perfect_hash_params
+		{
+			uint64_t multiplier = 1;
+			uint32_t bits = 0;
+		};
+
+		constexpr size_t perfect_hash_slot(cxpr::hash_t hash, perfect_hash_params params) noexcept
+		{
+			return (params.bits == 0) ? 0 : static_cast<size_t>((hash * params.multiplier) >> (64 - params.bits));
+		}
+
+		// Searches for a multiplier that sends every hash to its own slot, starting with the smallest power
+		// of 2 table that fits and doubling it whenever a batch of candidates fails. typehash_v values are
+		// already well mixed, so a multiply-shift is enough
+		template <size_t n>
+		constexpr perfect_hash_params find_perfect_hash(const std::array<cxpr::hash_t, n>& hashes)
+		{
+			uint32_t bits = 0;
+			while ((size_t(1) << bits) < n)
+			{
+				bits++;
+			}
+
+			constexpr uint32_t attempts_per_size = 64;
+			uint64_t candidate = 0x9E3779B97F4A7C15ull;
+			for (; bits < 24; bits++)
+			{
+				for (uint32_t attempt = 0; attempt < attempts_per_size; attempt++)
+				{
+					candidate = mum_mix(candidate, hash_secret[attempt & 3]) | 1;
+					const perfect_hash_params params{ candidate, bits };
+
+					bool distinct = true;
+					for (size_t i = 0; i < n && distinct; i++)
+					{
+						for (size_t j = i + 1; j < n && distinct; j++)
+						{
+							distinct = perfect_hash_slot(hashes[i], params) != perfect_hash_slot(hashes[j], params);
+						}
+					}
+
+					if (distinct)
+					{
+						return params;
+					}
+				}
+			}
+
+			throw std::logic_error("no perfect hash found for type set"); // not real, this will stop the compile
+		}
+
+		// Slot -> dense index table for the parameters found above
+		template <typename index_t, uint32_t bits, size_t n>
+		constexpr std::array<index_t, (size_t(1) << bits)> perfect_hash_slots(const std::array<cxpr::hash_t, n>& hashes,
+			perfect_hash_params params) noexcept
+		{
+			std::array<index_t, (size_t(1) << bits)> out{};
+			for (size_t i = 0; i < n; i++)
+			{
+				out[perfect_hash_slot(hashes[i], params)] = static_cast<index_t>(i);
+			}
+			return out;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Fixed storage for one value per type in a typeset (or tuple). Every type gets a dense index during
+	// compile, so get<T>() is a plain array access. get(hash) resolves a runtime typehash_v through a
+	// perfect hash built at compile time (one multiply, one shift, one compare). Replaces
+	// std::unordered_map<std::type_index, value_t> without allocation or pointer chasing.
+	//
+	//	 cxpr::type_map<cxpr::typeset<login, logout, heartbeat>, handler_t> handlers;
+	//	 handlers.get<login>() = &on_login;
+	//	 if (auto* handler = handlers.get(msg.typehash)) { (*handler)(msg); }
+	//
+	// Types are decayed, so T, T& and const T& share an entry. Types whose hashes collide (see typehash_v)
+	// fail assert_unique_typehashes during compile
+	template <typename set_t, typename value_t>
+	class type_map;
+
+	template <template <typename ...> class set_t, typename ... types_t, typename value_t>
+	class type_map<set_t<types_t...>, value_t>
+	{
+	public:
+		using types = typeset<types_t...>;
+		using value_type = value_t;
+		using index_t = std::conditional_t<(sizeof...(types_t) < 256), uint8_t, uint16_t>;
+
+		static constexpr size_t npos = static_cast<size_t>(-1);
+		static constexpr size_t count = sizeof...(types_t);
+		static_assert(count > 0, "type_map needs at least one type");
+		static constexpr std::array<cxpr::hash_t, count> hashes = { typehash_v<types_t>... };
+
+		static_assert(assert_unique_typehashes<types>(), "type_map types must be unique");
+
+		template <typename T>
+		static constexpr bool contains = __detail::type_index_of<T, types_t...>() != count;
+
+		template <typename T>
+		static constexpr size_t index_of = __detail::type_index_of<T, types_t...>();
+
+		constexpr type_map() = default;
+
+		// One value per type, in typeset order
+		template <typename ... params_t, std::enable_if_t<sizeof...(params_t) == count
+			&& !(std::is_same_v<std::decay_t<params_t>, type_map> || ...), int> = 0>
+		constexpr explicit type_map(params_t&& ... params) : values{ value_t(std::forward<params_t>(params))... } {}
+
+		template <typename T>
+		[[nodiscard]] constexpr value_t& get() noexcept
+		{
+			static_assert(contains<T>, "type is not part of the type_map");
+			return values[index_of<T>];
+		}
+
+		template <typename T>
+		[[nodiscard]] constexpr const value_t& get() const noexcept
+		{
+			static_assert(contains<T>, "type is not part of the type_map");
+			return values[index_of<T>];
+		}
+
+		// Dense index for a runtime typehash_v, npos if the hash isn't one of ours
+		[[nodiscard]] static constexpr size_t find_index(cxpr::hash_t typehash) noexcept
+		{
+			const size_t idx = slots[__detail::perfect_hash_slot(typehash, params)];
+			return (hashes[idx] == typehash) ? idx : npos;
+		}
+
+		[[nodiscard]] constexpr value_t* get(cxpr::hash_t typehash) noexcept
+		{
+			const size_t idx = find_index(typehash);
+			return (idx == npos) ? nullptr : &values[idx];
+		}
+
+		[[nodiscard]] constexpr const value_t* get(cxpr::hash_t typehash) const noexcept
+		{
+			const size_t idx = find_index(typehash);
+			return (idx == npos) ? nullptr : &values[idx];
+		}
+
+		constexpr value_t& operator[](size_t idx) noexcept { return values[idx]; }
+		constexpr const value_t& operator[](size_t idx) const noexcept { return values[idx]; }
+
+		static constexpr size_t size() noexcept { return count; }
+		constexpr decltype(auto) begin() noexcept { return values.begin(); }
+		constexpr decltype(auto) begin() const noexcept { return values.begin(); }
+		constexpr decltype(auto) end() noexcept { return values.end(); }
+		constexpr decltype(auto) end() const noexcept { return values.end(); }
+
+	private:
+		static constexpr __detail::perfect_hash_params params = __detail::find_perfect_hash(hashes);
+
+		static constexpr auto slots = __detail::perfect_hash_slots<index_t, params.bits>(hashes, params);
+
+		std::array<value_t, count> values{};
+	};
+}
@@ -0,0 +1,343 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////
+// UTF validation and transcoding. The encoding is picked from the width of the code unit: 1 byte units
+// are UTF-8, 2 byte units UTF-16 and 4 byte units UTF-32 (so wchar_t follows the platform). Runs of ASCII
+// are found with the vectorized cxpr::ascii_prefix scan, everything else is decoded one code point at a time
+
+namespace cxpr
+{
+	enum class utf_status : uint8_t
+	{
+		ok,
+		invalid,	// malformed sequence, overlong encoding, unpaired surrogate or code point past U+10FFFF
+	};
+
+	struct utf_result
+	{
+		utf_status status = utf_status::ok;
+		size_t read = 0;	// input units consumed, or the offset of the bad sequence on failure
+		size_t written = 0; // output units produced (or needed when validating)
+
+		[[nodiscard]] constexpr explicit operator bool() const noexcept { return status == utf_status::ok; }
+	};
+
+	namespace __detail
+	{
+		constexpr bool is_surrogate(char32_t cp) noexcept
+		{
+			return cp >= 0xD800 && cp <= 0xDFFF;
+		}
+
+		// Decodes the code point at in[pos] and moves pos past it. Returns false and leaves pos alone if the
+		// input is malformed
+		template <typename char_t>
+		constexpr bool decode_utf(const char_t* in, size_t count, size_t& pos, char32_t& cp) noexcept
+		{
+			if constexpr (sizeof(char_t) == 1)
+			{
+				const auto lead = static_cast<uint8_t>(in[pos]);
+				if (lead < 0x80)
+				{
+					cp = lead;
+					pos++;
+					return true;
+				}
+
+				size_t len = 0;
+				char32_t smallest = 0;
+				if ((lead & 0xE0) == 0xC0)
+				{
+					len = 2;
+					cp = lead & 0x1F;
+					smallest = 0x80;
+				}
+				else if ((lead & 0xF0) == 0xE0)
+				{
+					len = 3;
+					cp = lead & 0x0F;
+					smallest = 0x800;
+				}
+				else if ((lead & 0xF8) == 0xF0)
+				{
+					len = 4;
+					cp = lead & 0x07;
+					smallest = 0x10000;
+				}
+				else
+				{	// stray continuation byte or invalid lead
+					return false;
+				}
+
+				if (len > count - pos)
+				{
+					return false;
+				}
+
+				for (size_t i = 1; i < len; i++)
+				{
+					const auto cont = static_cast<uint8_t>(in[pos + i]);
+					if ((cont & 0xC0) != 0x80)
+					{
+						return false;
+					}
+					cp = (cp << 6) | (cont & 0x3F);
+				}
+
+				// overlong forms, encoded surrogates and anything past the last plane are all rejected
+				if (cp < smallest || cp > 0x10FFFF || is_surrogate(cp))
+				{
+					return false;
+				}
+
+				pos += len;
+				return true;
+			}
+			else if constexpr (sizeof(char_t) == 2)
+			{
+				const char32_t lead = static_cast<uint16_t>(in[pos]);
+				if (is_surrogate(lead) == false)
+				{
+					cp = lead;
+					pos++;
+					return true;
+				}
+
+				if (lead >= 0xDC00 || pos + 1 >= count)
+				{
+					return false;
+				}
+
+				const char32_t trail = static_cast<uint16_t>(in[pos + 1]);
+				if (trail < 0xDC00 || trail > 0xDFFF)
+				{
+					return false;
+				}
+
+				cp = 0x10000 + ((lead - 0xD800) << 10) + (trail - 0xDC00);
+				pos += 2;
+				return true;
+			}
+			else
+			{
+				static_assert(sizeof(char_t) == 4, "code units must be 1, 2 or 4 bytes");
+				cp = static_cast<char32_t>(in[pos]);
+				if (cp > 0x10FFFF || is_surrogate(cp))
+				{
+					return false;
+				}
+
+				pos++;
+				return true;
+			}
+		}
+
+		template <size_t width>
+		constexpr size_t encoded_units(char32_t cp) noexcept
+		{
+			if constexpr (width == 1)
+			{
+				return (cp < 0x80) ? 1 : (cp < 0x800) ? 2 : (cp < 0x10000) ? 3 : 4;
+			}
+			else if constexpr (width == 2)
+			{
+				return (cp < 0x10000) ? 1 : 2;
+			}
+			else
+			{
+				return 1;
+			}
+		}
+
+		// Writes the code point to out, returns the number of units written
+		template <typename char_t>
+		constexpr size_t encode_utf(char32_t cp, char_t* out) noexcept
+		{
+			if constexpr (sizeof(char_t) == 1)
+			{
+				if (cp < 0x80)
+				{
+					out[0] = static_cast<char_t>(cp);
+					return 1;
+				}
+				if (cp < 0x800)
+				{
+					out[0] = static_cast<char_t>(0xC0 | (cp >> 6));
+					out[1] = static_cast<char_t>(0x80 | (cp & 0x3F));
+					return 2;
+				}
+				if (cp < 0x10000)
+				{
+					out[0] = static_cast<char_t>(0xE0 | (cp >> 12));
+					out[1] = static_cast<char_t>(0x80 | ((cp >> 6) & 0x3F));
+					out[2] = static_cast<char_t>(0x80 | (cp & 0x3F));
+					return 3;
+				}
+				out[0] = static_cast<char_t>(0xF0 | (cp >> 18));
+				out[1] = static_cast<char_t>(0x80 | ((cp >> 12) & 0x3F));
+				out[2] = static_cast<char_t>(0x80 | ((cp >> 6) & 0x3F));
+				out[3] = static_cast<char_t>(0x80 | (cp & 0x3F));
+				return 4;
+			}
+			else if constexpr (sizeof(char_t) == 2)
+			{
+				if (cp < 0x10000)
+				{
+					out[0] = static_cast<char_t>(cp);
+					return 1;
+				}
+				cp -= 0x10000;
+				out[0] = static_cast<char_t>(0xD800 + (cp >> 10));
+				out[1] = static_cast<char_t>(0xDC00 + (cp & 0x3FF));
+				return 2;
+			}
+			else
+			{
+				out[0] = static_cast<char_t>(cp);
+				return 1;
+			}
+		}
+
+		// Validates the input and counts the units it takes in the out_width encoding
+		template <size_t out_width, typename in_t>
+		constexpr utf_result measure_utf(const in_t* in, size_t count) noexcept
+		{
+			utf_result res{};
+			size_t pos = 0;
+			while (pos < count)
+			{
+				const size_t run = cxpr::ascii_prefix(in + pos, count - pos);
+				pos += run;
+				res.written += run;
+				if (pos == count)
+				{
+					break;
+				}
+
+				char32_t cp = 0;
+				if (decode_utf(in, count, pos, cp) == false)
+				{
+					res.status = utf_status::invalid;
+					res.read = pos;
+					return res;
+				}
+				res.written += encoded_units<out_width>(cp);
+			}
+
+			res.read = pos;
+			return res;
+		}
+
+		// Converts already validated input, stopping before the first code point that would take the output
+		// past 'limit' units. Output is staged in a small buffer and appended in chunks
+		template <typename string_t, typename in_t>
+		constexpr utf_result transcode_valid(string_t& out, const in_t* in, size_t count, size_t limit)
+		{
+			using out_t = typename string_t::value_type;
+			constexpr size_t chunk_size = 128;
+			std::array<out_t, chunk_size> chunk{};
+			size_t used = 0;
+
+			utf_result res{};
+			size_t pos = 0;
+			while (pos < count)
+			{
+				size_t run = std::min(cxpr::ascii_prefix(in + pos, count - pos), limit - res.written);
+				res.written += run;
+				while (run > 0)
+				{
+					const size_t n = std::min(run, chunk_size - used);
+					for (size_t i = 0; i < n; i++)
+					{
+						chunk[used + i] = static_cast<out_t>(in[pos + i]);
+					}
+					used += n;
+					pos += n;
+					run -= n;
+					if (used == chunk_size)
+					{
+						out.append(std::basic_string_view<out_t>(chunk.data(), used));
+						used = 0;
+					}
+				}
+				if (pos == count)
+				{
+					break;
+				}
+
+				const size_t start = pos;
+				char32_t cp = 0;
+				decode_utf(in, count, pos, cp);
+				const size_t units = encoded_units<sizeof(out_t)>(cp);
+				if (res.written + units > limit)
+				{
+					pos = start;
+					break;
+				}
+
+				if (used + units > chunk_size)
+				{
+					out.append(std::basic_string_view<out_t>(chunk.data(), used));
+					used = 0;
+				}
+				used += encode_utf(cp, chunk.data() + used);
+				res.written += units;
+			}
+
+			out.append(std::basic_string_view<out_t>(chunk.data(), used));
+			res.read = pos;
+			return res;
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Checks that the source is well formed, 'written' is set to the number of code points in it
+	//	 if (!cxpr::validate_utf(payload)) { reject(payload); }
+	template <typename source_t>
+	[[nodiscard]] constexpr utf_result validate_utf(const source_t& source) noexcept
+	{
+		using view_t = std::basic_string_view<__detail::source_char_t<source_t>>;
+		const view_t in(source);
+		return __detail::measure_utf<4>(in.data(), in.size());
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Appends the source to a basic_fixed_string, re-encoded to match the string's code unit width:
+	//	 cxpr::fixed_string<64> name;
+	//	 cxpr::transcode_append(name, std::u16string_view(u"café"));  // UTF-16 -> UTF-8
+	// Malformed input appends nothing and the result holds the offset of the bad sequence. Output that doesn't
+	// fit follows the string's overrun_behavior: it either throws before anything is written or is cut at the
+	// last whole code point
+	template <typename string_t, typename source_t>
+	constexpr utf_result transcode_append(string_t& out, const source_t& source)
+	{
+		using out_t = typename string_t::value_type;
+		using view_t = std::basic_string_view<__detail::source_char_t<source_t>>;
+		const view_t in(source);
+
+		const auto measured = __detail::measure_utf<sizeof(out_t)>(in.data(), in.size());
+		if (measured.status != utf_status::ok)
+		{
+			return utf_result{ measured.status, measured.read, 0 };
+		}
+
+		const size_t available = out.capacity() - out.size();
+		if constexpr (string_t::throw_on_overrun)
+		{
+			if (measured.written > available)
+			{
+				throw std::runtime_error("string too small for contents, aborting assignment");
+			}
+		}
+
+		return __detail::transcode_valid(out, in.data(), in.size(), std::min(measured.written, available));
+	}
+
+	// Replaces the contents of out with the transcoded source, see transcode_append
+	template <typename string_t, typename source_t>
+	constexpr utf_result transcode(string_t& out, const source_t& source)
+	{
+		out.clear();
+		return transcode_append(out, source);
+	}
+}
@@ -1,17 +1,273 @@
+#pragma once
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define CXPR_UNREACHABLE() __assume(0)
+#else
+	#define CXPR_UNREACHABLE() __builtin_unreachable()
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+
 namespace cxpr
 {
-	template <typename fun_t, template<typename ...> typename variant_t, typename ... Ts>
-	constexpr decltype(auto) jump_visit(fun_t&& fun, const variant_t<Ts...>& v)
+	namespace __detail
 	{
- 		using functor_t = void(*)(fun_t && fun, decltype(v) var);
- 		constexpr std::array<functor_t, sizeof...(Ts)> jump_table =
- 		{
- 			[](fun_t&& fun, auto& var) constexpr
- 			{
- 				return fun(*std::get_if<Ts>(&var));
- 			}...
- 		};
- 
- 		return jump_table[v.index()](std::forward<fun_t>(fun), v);
+		// Variant-like classes (compact_variant) opt in with a static alternative_count and a get_alternative<idx>()
+		// member, everything else goes through std::variant_size/std::get_if
+		template <typename variant_t, typename = void>
+		struct variant_size : std::variant_size<variant_t> {};
+
+		template <typename variant_t>
+		struct variant_size<variant_t, std::void_t<decltype(variant_t::alternative_count)>>
+			: std::integral_constant<size_t, variant_t::alternative_count> {};
+
+		template <typename variant_t>
+		constexpr size_t variant_size_v = variant_size<std::remove_cv_t<std::remove_reference_t<variant_t>>>::value;
+
+		template <typename variant_t, typename = void>
+		constexpr bool is_variant_like_v = false;
+
+		template <typename variant_t>
+		constexpr bool is_variant_like_v<variant_t, std::void_t<decltype(variant_t::alternative_count)>> = true;
+
+		// Alternative idx with the variant's constness and value category, the caller has already checked index()
+		template <size_t idx, typename variant_t>
+		constexpr decltype(auto) unchecked_get(variant_t&& v) noexcept
+		{
+			if constexpr (is_variant_like_v<std::remove_cv_t<std::remove_reference_t<variant_t>>>)
+			{
+				return std::forward<variant_t>(v).template get_alternative<idx>();
+			}
+			else
+			{
+				using alt_t = decltype(std::get<idx>(std::forward<variant_t>(v)));
+				return static_cast<alt_t>(*std::get_if<idx>(&v));
+			}
+		}
+
+		// One table entry per combination of alternatives, flattened row-major (the last variant varies fastest)
+		template <typename fun_t, typename ... variants_t>
+		struct jump_visitor
+		{
+			static constexpr size_t count = sizeof...(variants_t);
+			static constexpr size_t sizes[] = { variant_size_v<variants_t>... };
+			static constexpr size_t cells = (variant_size_v<variants_t> * ... * 1);
+
+			// Alternative of variant 'which' in a flattened cell
+			static constexpr size_t alternative(size_t cell, size_t which) noexcept
+			{
+				size_t stride = 1;
+				for (size_t i = which + 1; i < count; i++)
+				{
+					stride *= sizes[i];
+				}
+				return (cell / stride) % sizes[which];
+			}
+
+			template <size_t cell, size_t ... which>
+			static auto cell_result(std::index_sequence<which...>) -> std::invoke_result_t<fun_t,
+				decltype(unchecked_get<alternative(cell, which)>(std::declval<variants_t>()))...>;
+
+			template <size_t ... cell>
+			static auto table_result(std::index_sequence<cell...>)
+				-> typename visit_result<decltype(cell_result<cell>(std::make_index_sequence<count>{}))...>::type;
+
+			using result_t = decltype(table_result(std::make_index_sequence<cells>{}));
+
+			template <size_t cell, size_t ... which>
+			static constexpr result_t dispatch(std::index_sequence<which...>, fun_t&& fun, variants_t&& ... vs)
+			{
+				return static_cast<result_t>(std::forward<fun_t>(fun)(
+					unchecked_get<alternative(cell, which)>(std::forward<variants_t>(vs))...));
+			}
+
+			template <size_t cell>
+			static constexpr result_t call(fun_t&& fun, variants_t&& ... vs)
+			{
+				return dispatch<cell>(std::make_index_sequence<count>{}, std::forward<fun_t>(fun), std::forward<variants_t>(vs)...);
+			}
+
+			using entry_t = result_t(*)(fun_t&& fun, variants_t&& ... vs);
+
+			template <size_t ... cell>
+			static constexpr std::array<entry_t, cells> make_table(std::index_sequence<cell...>) noexcept
+			{
+				return { &call<cell>... };
+			}
+
+			static constexpr std::array<entry_t, cells> table = make_table(std::make_index_sequence<cells>{});
+
+			// Small tables are dispatched through a switch instead: the compiler sees every call, can inline
+			// them and pick branches or a jump table itself
+			static constexpr size_t switch_limit = 16;
+
+			static constexpr result_t switch_call(size_t cell, fun_t&& fun, variants_t&& ... vs)
+			{
+#define CXPR_JUMP_VISIT_CASE(n)																		\
+				case n:																						\
+					if constexpr (n < cells)																\
+					{																						\
+						return call<n>(std::forward<fun_t>(fun), std::forward<variants_t>(vs)...);			\
+					}																						\
+					break;
+
+				switch (cell)
+				{
+					CXPR_JUMP_VISIT_CASE(0)  CXPR_JUMP_VISIT_CASE(1)  CXPR_JUMP_VISIT_CASE(2)  CXPR_JUMP_VISIT_CASE(3)
+					CXPR_JUMP_VISIT_CASE(4)  CXPR_JUMP_VISIT_CASE(5)  CXPR_JUMP_VISIT_CASE(6)  CXPR_JUMP_VISIT_CASE(7)
+					CXPR_JUMP_VISIT_CASE(8)  CXPR_JUMP_VISIT_CASE(9)  CXPR_JUMP_VISIT_CASE(10) CXPR_JUMP_VISIT_CASE(11)
+					CXPR_JUMP_VISIT_CASE(12) CXPR_JUMP_VISIT_CASE(13) CXPR_JUMP_VISIT_CASE(14) CXPR_JUMP_VISIT_CASE(15)
+				}
+#undef CXPR_JUMP_VISIT_CASE
+
+				CXPR_UNREACHABLE(); // cell is always below cells
+			}
+
+			static constexpr size_t flat_index(const variants_t& ... vs) noexcept
+			{
+				size_t cell = 0;
+				((cell = cell * variant_size_v<variants_t> + vs.index()), ...);
+				return cell;
+			}
+		};
 	}
-}
\ No newline at end of file
+
+	//////////////////////////////////////////////////////////////////////////
+	// std::visit replacement that flattens any number of variants into one index, then dispatches with a
+	// single switch (up to 16 combinations) or a single indirect call through a table of function pointers.
+	//	 auto area = cxpr::jump_visit([](const auto& shape) { return shape.area(); }, shape);
+	//	 cxpr::jump_visit(collide, lhs, rhs); // lhs.index() * rhs_alternatives + rhs.index()
+	// Variants are passed on with their constness and value category, so the visitor can modify or move
+	// from the held value. The result is the common type of every call (references are kept when all calls
+	// agree). Throws std::bad_variant_access if any variant is valueless.
+	// For a single variant of up to 11 alternatives this is not a win: libstdc++'s std::visit switches as well
+	// and g++ emits the same code for both. The gain is with several variants, which std::visit sends through
+	// a table
+	template <typename fun_t, typename ... variants_t>
+	constexpr decltype(auto) jump_visit(fun_t&& fun, variants_t&& ... vs)
+	{
+		static_assert(sizeof...(variants_t) > 0, "jump_visit needs at least one variant");
+		using visitor_t = __detail::jump_visitor<fun_t, variants_t...>;
+
+		if ((vs.valueless_by_exception() || ...))
+		{
+			throw std::bad_variant_access();
+		}
+
+		const size_t cell = visitor_t::flat_index(vs...);
+		if constexpr (visitor_t::cells <= visitor_t::switch_limit)
+		{
+			return visitor_t::switch_call(cell, std::forward<fun_t>(fun), std::forward<variants_t>(vs)...);
+		}
+		else
+		{
+			return visitor_t::table[cell](std::forward<fun_t>(fun), std::forward<variants_t>(vs)...);
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+
+	enum class batch_order : uint8_t
+	{
+		blocked,		// no allocation, the range is grouped and visited 256 items at a time
+		whole_range,	// one counting sort over the whole range into 'scratch', each alternative is visited as one group
+	};
+
+	namespace __detail
+	{
+		template <typename range_t>
+		using range_variant_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<range_t&>()))>>;
+
+		template <size_t idx, typename iter_t, typename fun_t>
+		void visit_group(iter_t first, fun_t& fun, const size_t* indices, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				fun(*std::get_if<idx>(&first[indices[i]]));
+			}
+		}
+
+		template <typename iter_t, typename fun_t, size_t ... idx>
+		void visit_groups(iter_t first, fun_t& fun, const size_t* indices, const size_t* offsets, std::index_sequence<idx...>)
+		{
+			(visit_group<idx>(first, fun, indices + offsets[idx], offsets[idx + 1] - offsets[idx]), ...);
+		}
+
+		// Counting sort of the indices [begin, begin + count) by alternative, which keeps range order inside
+		// each group. Group a ends up in indices[offsets[a]] .. indices[offsets[a + 1]]
+		template <size_t alternatives, typename iter_t>
+		void group_indices(iter_t first, size_t begin, size_t count, size_t* indices, size_t* offsets)
+		{
+			std::array<size_t, alternatives + 1> next{};
+			bool valueless = false;
+			for (size_t i = begin; i < begin + count; i++)
+			{
+				const size_t kind = first[i].index();
+				valueless |= kind >= alternatives; // variant_npos for valueless variants
+				next[std::min(kind, alternatives - 1) + 1]++;
+			}
+			if (valueless)
+			{
+				throw std::bad_variant_access();
+			}
+
+			for (size_t alt = 0; alt < alternatives; alt++)
+			{
+				next[alt + 1] += next[alt];
+				offsets[alt] = next[alt];
+			}
+			offsets[alternatives] = count;
+
+			for (size_t i = begin; i < begin + count; i++)
+			{
+				indices[next[first[i].index()]++] = i;
+			}
+		}
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// Visits a range of variants grouped by alternative instead of in range order, so fun is called in
+	// tight per-type loops with nothing to mispredict:
+	//	 cxpr::batch_visit(messages, overloaded{ [&](const login& m) {...}, [&](const logout& m) {...} });
+	// Items of the same alternative are always visited in range order. The default groups blocks of 256
+	// items on the stack, so alternatives interleave at block boundaries. batch_order::whole_range counting
+	// sorts the whole range first so each alternative is one group, 'scratch' holds the sorted indices and
+	// can be reused between calls (it is ignored by batch_order::blocked). Valueless variants throw
+	// std::bad_variant_access before anything in their block (or the range, for whole_range) is visited
+	template <batch_order order = batch_order::blocked, typename range_t, typename fun_t>
+	void batch_visit(range_t&& range, fun_t&& fun, std::vector<size_t>& scratch)
+	{
+		using variant_t = __detail::range_variant_t<range_t>;
+		constexpr size_t alternatives = std::variant_size_v<variant_t>;
+		constexpr auto groups = std::make_index_sequence<alternatives>{};
+
+		const auto first = std::begin(range);
+		const size_t count = static_cast<size_t>(std::distance(first, std::end(range)));
+		std::array<size_t, alternatives + 1> offsets;
+
+		if constexpr (order == batch_order::whole_range)
+		{
+			scratch.resize(count);
+			__detail::group_indices<alternatives>(first, 0, count, scratch.data(), offsets.data());
+			__detail::visit_groups(first, fun, scratch.data(), offsets.data(), groups);
+		}
+		else
+		{
+			constexpr size_t block_size = 256;
+			std::array<size_t, block_size> indices;
+			for (size_t begin = 0; begin < count; begin += block_size)
+			{
+				const size_t block = std::min(block_size, count - begin);
+				__detail::group_indices<alternatives>(first, begin, block, indices.data(), offsets.data());
+				__detail::visit_groups(first, fun, indices.data(), offsets.data(), groups);
+			}
+		}
+	}
+
+	template <batch_order order = batch_order::blocked, typename range_t, typename fun_t>
+	void batch_visit(range_t&& range, fun_t&& fun)
+	{
+		std::vector<size_t> scratch;
+		batch_visit<order>(std::forward<range_t>(range), std::forward<fun_t>(fun), scratch);
+	}
+}
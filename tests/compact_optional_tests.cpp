@@ -0,0 +1,99 @@
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	enum class side : uint8_t { buy, sell };
+	struct order
+	{
+		uint32_t qty;
+		uint16_t venue;
+		uint8_t flags;
+		side direction;	// only 0 and 1 are used
+		static constexpr size_t niche_offset = 7;
+		static constexpr size_t niche_first_free = 2;
+	};
+
+	using qty_t = cxpr::compact_optional<uint32_t, cxpr::sentinel_policy<uint32_t, UINT32_MAX>>;
+}
+
+TEST(compact_optional_tests, size_test)
+{
+	static_assert(sizeof(qty_t) == sizeof(uint32_t), "sentinel adds no storage");
+	static_assert(sizeof(cxpr::compact_optional<double>) == sizeof(double), "NaN is empty");
+	static_assert(sizeof(cxpr::compact_optional<order>) == sizeof(order), "niche byte is empty");
+	static_assert(std::is_same_v<cxpr::compact_optional<float>::policy_type, cxpr::nan_policy<float>>, "floats default to NaN");
+	static_assert(std::is_same_v<cxpr::compact_optional<bool>::policy_type, cxpr::niche_policy<bool>>, "bool has a niche");
+
+	// usable during compile with sentinel and NaN policies
+	constexpr qty_t none;
+	constexpr qty_t some = 5u;
+	static_assert(!none.has_value() && some.has_value() && *some == 5, "constexpr");
+	constexpr cxpr::compact_optional<double> price = 1.5;
+	static_assert(price.value_or(0.0) == 1.5, "constexpr");
+}
+
+TEST(compact_optional_tests, value_test)
+{
+	qty_t qty;
+	EXPECT_FALSE(qty);
+	EXPECT_THROW((void)qty.value(), std::bad_optional_access);
+	EXPECT_EQ(qty.value_or(7), 7);
+
+	qty = 10u;
+	EXPECT_TRUE(qty);
+	EXPECT_EQ(qty.value(), 10);
+	qty = UINT32_MAX; // the sentinel itself means empty
+	EXPECT_FALSE(qty);
+	qty.emplace(3u);
+	qty.reset();
+	EXPECT_FALSE(qty.has_value());
+
+	cxpr::compact_optional<double> price;
+	EXPECT_FALSE(price);
+	price = 2.25;
+	EXPECT_EQ(*price, 2.25);
+	price = std::nullopt;
+	EXPECT_FALSE(price);
+
+	cxpr::compact_optional<order> pending;
+	EXPECT_FALSE(pending);
+	pending = order{ 100, 2, 0, side::sell };
+	ASSERT_TRUE(pending);
+	EXPECT_EQ(pending->qty, 100);
+	EXPECT_EQ(pending->direction, side::sell);
+
+	cxpr::compact_optional<bool> flag;
+	EXPECT_FALSE(flag);
+	flag = false;
+	EXPECT_TRUE(flag.has_value());
+	EXPECT_FALSE(*flag);
+}
+
+TEST(compact_optional_tests, combinator_test)
+{
+	qty_t qty = 4u;
+
+	auto doubled = qty.apply([](uint32_t v) { return v * 2; });
+	static_assert(std::is_same_v<decltype(doubled), cxpr::optional_ex<uint32_t>>, "results are wrapped in optional_ex");
+	EXPECT_EQ(doubled.value(), 8);
+
+	auto as_price = qty.and_then([](uint32_t v) { return cxpr::compact_optional<double>(v * 0.5); });
+	static_assert(std::is_same_v<decltype(as_price), cxpr::compact_optional<double>>, "compact results are kept");
+	EXPECT_EQ(*as_price, 2.0);
+
+	qty.map([](uint32_t& v) { v += 1; });
+	EXPECT_EQ(*qty, 5);
+
+	int fallbacks = 0;
+	qty.or_else([&] { fallbacks++; });
+	qty.reset();
+	qty.or_else([&] { fallbacks++; }).map([](uint32_t& v) { v = 0; });
+	EXPECT_EQ(fallbacks, 1);
+	EXPECT_FALSE(qty.apply([](uint32_t v) { return v; }).has_value());
+}
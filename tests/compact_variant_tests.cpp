@@ -0,0 +1,109 @@
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct alignas(8) fill
+	{
+		uint32_t qty;
+		uint16_t venue;
+		uint8_t side;
+		uint8_t reserved;
+		static constexpr size_t niche_offset = 7;
+	};
+
+	struct alignas(8) cancel
+	{
+		uint32_t order;
+		uint8_t reason;
+		uint8_t pad[2];
+		uint8_t reserved;
+		static constexpr size_t niche_offset = 7;
+	};
+
+	struct heartbeat { uint32_t seq; }; // ends before the niche byte, needs no declaration
+
+	// only uses values 0..2 in its last byte
+	struct alignas(8) status
+	{
+		uint32_t code;
+		uint8_t pad[3];
+		uint8_t level;
+		static constexpr size_t niche_offset = 7;
+		static constexpr size_t niche_first_free = 3;
+	};
+}
+
+TEST(compact_variant_tests, layout_test)
+{
+	using event_t = cxpr::compact_variant<fill, cancel, heartbeat>;
+	static_assert(event_t::uses_niche, "the reserved bytes hold the index");
+	static_assert(sizeof(event_t) == 8, "no room taken beyond the largest alternative");
+	static_assert(sizeof(std::variant<fill, cancel, heartbeat>) == 16, "std::variant needs another word");
+	static_assert(std::is_trivially_copyable_v<event_t>, "copies are a memcpy");
+
+	using with_holder_t = cxpr::compact_variant<status, fill, heartbeat>;
+	static_assert(with_holder_t::uses_niche && sizeof(with_holder_t) == 8, "status values share the byte with the index");
+
+	using plain_t = cxpr::compact_variant<int32_t, float>;
+	static_assert(!plain_t::uses_niche && sizeof(plain_t) == 8, "no niche, a one byte index after the value");
+	static_assert(std::is_same_v<plain_t::index_t, uint8_t>, "smallest index type");
+
+	using bool_t = cxpr::compact_variant<bool, char>;
+	static_assert(!bool_t::uses_niche, "char overlaps the bool byte without declaring it free");
+	using flag_t = cxpr::compact_variant<bool, std::tuple<>>;
+	static_assert(flag_t::uses_niche && sizeof(flag_t) == 1, "bool's unused values hold the index");
+}
+
+TEST(compact_variant_tests, access_test)
+{
+	cxpr::compact_variant<fill, cancel, heartbeat> event;
+	EXPECT_EQ(event.index(), 0);
+	EXPECT_EQ(event.get<fill>().qty, 0);
+
+	event = cancel{ 42, 3, {}, 0 };
+	EXPECT_EQ(event.index(), 1);
+	EXPECT_TRUE(event.holds_alternative<cancel>());
+	EXPECT_EQ(event.get<cancel>().order, 42);
+	EXPECT_EQ(event.get_if<fill>(), nullptr);
+	EXPECT_THROW((void)event.get<heartbeat>(), std::bad_variant_access);
+
+	event.emplace<heartbeat>(heartbeat{ 9 });
+	EXPECT_EQ(event.index(), 2);
+	EXPECT_EQ(event.visit([](const auto& e) -> uint32_t
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(e)>, heartbeat>) { return e.seq; } else { return 0; }
+		}), 9);
+
+	// overwriting the whole value (reserved byte included) keeps the index intact
+	event = fill{ 5, 1, 'B', 0 };
+	event.visit([](auto& e)
+	{
+		if constexpr (std::is_same_v<std::decay_t<decltype(e)>, fill>)
+		{
+			e = fill{ 7, 1, 'S', 0 };
+		}
+	});
+	EXPECT_EQ(event.index(), 0);
+	EXPECT_EQ(event.get<fill>().qty, 7);
+
+	// works with the free jump_visit, including several variants at once
+	cxpr::compact_variant<status, fill, heartbeat> other = status{ 1, {}, 2 };
+	EXPECT_EQ(other.index(), 0);
+	EXPECT_EQ(other.get<status>().level, 2);
+	other = heartbeat{ 3 };
+	EXPECT_EQ(other.index(), 2);
+	const auto sizes = cxpr::jump_visit([](const auto& a, const auto& b) { return sizeof(a) * 10 + sizeof(b); }, event, other);
+	EXPECT_EQ(sizes, sizeof(fill) * 10 + sizeof(heartbeat));
+
+	cxpr::compact_variant<bool, std::tuple<>> flag = true;
+	EXPECT_EQ(flag.index(), 0);
+	EXPECT_TRUE(flag.get<bool>());
+	flag = std::tuple<>{};
+	EXPECT_EQ(flag.index(), 1);
+}
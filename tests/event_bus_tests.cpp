@@ -0,0 +1,87 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct order_placed { int id; };
+	struct order_filled { int id; double price; };
+	struct shutdown {};
+
+	using bus_t = cxpr::event_bus<cxpr::typeset<order_placed, order_filled, shutdown>, 4>;
+
+	struct recorder
+	{
+		std::vector<std::string> seen;
+		void operator()(const order_placed& e) { seen.push_back("placed " + std::to_string(e.id)); }
+		void operator()(const order_filled& e) { seen.push_back("filled " + std::to_string(e.id)); }
+	};
+}
+
+TEST(event_bus_tests, publish_test)
+{
+	bus_t bus;
+	recorder first;
+	recorder second;
+	bus.subscribe<order_placed>(first);
+	bus.subscribe<order_filled>(first);
+	bus.subscribe<order_filled>(second);
+
+	int shutdowns = 0;
+	auto on_shutdown = [&shutdowns](const shutdown&) { shutdowns++; };
+	bus.subscribe<shutdown>(on_shutdown);
+
+	bus.publish(order_placed{ 1 });
+	bus.publish(order_filled{ 1, 10.5 });
+	bus.publish(shutdown{});
+
+	EXPECT_EQ(first.seen, std::vector<std::string>({ "placed 1", "filled 1" }));
+	EXPECT_EQ(second.seen, std::vector<std::string>({ "filled 1" }));
+	EXPECT_EQ(shutdowns, 1);
+
+	// raw function pointer + context
+	int total = 0;
+	bus.subscribe<order_placed>([](void* context, const order_placed& e) { *static_cast<int*>(context) += e.id; }, &total);
+	bus.publish(order_placed{ 5 });
+	EXPECT_EQ(total, 5);
+	EXPECT_EQ(bus.subscriber_count<order_placed>(), 2);
+}
+
+TEST(event_bus_tests, type_erased_publish_test)
+{
+	bus_t bus;
+	recorder rec;
+	bus.subscribe<order_filled>(rec);
+
+	const order_filled filled{ 7, 1.0 };
+	EXPECT_TRUE(bus.publish(cxpr::typehash_v<order_filled>, &filled));
+	EXPECT_FALSE(bus.publish(cxpr::typehash_v<int>, &filled));
+	EXPECT_EQ(rec.seen, std::vector<std::string>({ "filled 7" }));
+}
+
+TEST(event_bus_tests, subscription_limits_test)
+{
+	bus_t bus;
+	recorder recs[5];
+	for (size_t i = 0; i < 4; i++)
+	{
+		bus.subscribe<order_placed>(recs[i]);
+	}
+	EXPECT_THROW(bus.subscribe<order_placed>(recs[4]), std::out_of_range);
+
+	EXPECT_EQ(bus.unsubscribe<order_placed>(&recs[1]), 1);
+	EXPECT_EQ(bus.unsubscribe<order_placed>(&recs[4]), 0);
+	bus.subscribe<order_placed>(recs[4]);
+
+	bus.publish(order_placed{ 3 });
+	EXPECT_TRUE(recs[1].seen.empty());
+	for (size_t i : { 0, 2, 3, 4 })
+	{
+		EXPECT_EQ(recs[i].seen.size(), 1) << i;
+	}
+}
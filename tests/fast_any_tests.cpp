@@ -0,0 +1,120 @@
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct tracked
+	{
+		static inline int alive = 0;
+		int value = 0;
+
+		tracked(int v) : value(v) { alive++; }
+		tracked(const tracked& other) : value(other.value) { alive++; }
+		tracked(tracked&& other) noexcept : value(other.value) { alive++; }
+		~tracked() { alive--; }
+	};
+
+	template <typename any_t, typename T, typename = void>
+	struct can_hold : std::false_type {};
+
+	template <typename any_t, typename T>
+	struct can_hold<any_t, T, std::void_t<decltype(std::declval<any_t&>().template emplace<T>())>> : std::true_type {};
+}
+
+TEST(fast_any_tests, store_and_get_test)
+{
+	cxpr::fast_any<32> attr;
+	EXPECT_FALSE(attr.has_value());
+	EXPECT_EQ(attr.type(), 0);
+	EXPECT_EQ(attr.get<int>(), nullptr);
+
+	attr = 42;
+	ASSERT_TRUE(attr.is<int>());
+	EXPECT_EQ(*attr.get<int>(), 42);
+	EXPECT_EQ(attr.get<long>(), nullptr);
+	EXPECT_EQ(attr.type(), cxpr::typehash_v<int>);
+
+	attr = std::string("gzip, deflate");
+	EXPECT_EQ(attr.cast<std::string>(), "gzip, deflate");
+	EXPECT_THROW((void)attr.cast<int>(), std::runtime_error);
+
+	attr.emplace<std::string_view>("br");
+	EXPECT_EQ(attr.cast<std::string_view>(), "br");
+
+	static_assert(cxpr::fast_any<8>::fits_v<double>, "double fits in 8 bytes");
+	static_assert(!cxpr::fast_any<8>::fits_v<std::string>, "string doesn't fit in 8 bytes");
+	static_assert(!cxpr::fast_any<16, 4>::fits_v<double>, "alignment is checked");
+}
+
+TEST(fast_any_tests, lifetime_test)
+{
+	{
+		cxpr::fast_any<16> a = tracked(5);
+		EXPECT_EQ(tracked::alive, 1);
+
+		cxpr::fast_any<16> b = a;	// copy
+		EXPECT_EQ(tracked::alive, 2);
+		EXPECT_EQ(b.cast<tracked>().value, 5);
+
+		cxpr::fast_any<16> c = std::move(a); // move leaves the source empty
+		EXPECT_EQ(tracked::alive, 2);
+		EXPECT_FALSE(a.has_value());
+		EXPECT_EQ(c.cast<tracked>().value, 5);
+
+		b = 3.5;	// replacing destroys the old value
+		EXPECT_EQ(tracked::alive, 1);
+
+		a = c;
+		EXPECT_EQ(tracked::alive, 2);
+		c.reset();
+		EXPECT_EQ(tracked::alive, 1);
+	}
+	EXPECT_EQ(tracked::alive, 0);
+
+	// shared_ptr is copyable and nothrow movable, the count shows copies and moves are real
+	auto shared = std::make_shared<int>(1);
+	cxpr::fast_any<32> holder = shared;
+	cxpr::fast_any<32> copy = holder;
+	EXPECT_EQ(shared.use_count(), 3);
+	holder = cxpr::fast_any<32>{};
+	EXPECT_EQ(shared.use_count(), 2);
+}
+
+TEST(fast_any_tests, assign_held_value_test)
+{	// the new value is built from the held one before that one is destroyed
+	cxpr::fast_any<64> attr = std::string(40, 'x');
+	attr = *attr.get<std::string>();
+	EXPECT_EQ(attr.cast<std::string>(), std::string(40, 'x'));
+
+	attr.emplace<std::string>(attr.cast<std::string>(), 0, 10);
+	EXPECT_EQ(attr.cast<std::string>(), std::string(10, 'x'));
+
+	{
+		cxpr::fast_any<16> a = tracked(7);
+		a = a.cast<tracked>();
+		EXPECT_EQ(a.cast<tracked>().value, 7);
+		EXPECT_EQ(tracked::alive, 1);
+	}
+	EXPECT_EQ(tracked::alive, 0);
+}
+
+TEST(fast_any_tests, same_named_types_test)
+{	// GCC names both lambdas '<lambda(int)>' in this scope, so their typehash_v may be equal
+	const int base = 2;
+	const double scale = 0.5;
+	auto add = [base](int v) { return v + base; };
+	auto mul = [scale](int v) { return static_cast<int>(v * scale); };
+
+	cxpr::fast_any<32> attr = add;
+	EXPECT_TRUE(attr.is<decltype(add)>());
+	EXPECT_FALSE(attr.is<decltype(mul)>());
+	EXPECT_EQ(attr.get<decltype(mul)>(), nullptr);
+	EXPECT_THROW((void)attr.cast<decltype(mul)>(), std::runtime_error);
+	EXPECT_EQ((*attr.get<decltype(add)>())(3), 5);
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	int twice(int v) { return v * 2; }
+	int add_one(int v) { return v + 1; }
+}
+
+TEST(inplace_function_tests, call_test)
+{
+	cxpr::inplace_function<int(int)> fun;
+	EXPECT_FALSE(fun);
+	EXPECT_THROW(fun(1), std::bad_function_call);
+
+	fun = &twice;
+	ASSERT_TRUE(fun);
+	EXPECT_EQ(fun(21), 42);
+	EXPECT_NE(fun.target<int(*)(int)>(), nullptr);
+	EXPECT_EQ(fun.target<long(*)(int)>(), nullptr);
+
+	int offset = 10;
+	fun = [offset](int v) { return v + offset; };
+	EXPECT_EQ(fun(5), 15);
+	EXPECT_EQ(fun.target<int(*)(int)>(), nullptr);
+
+	// state in a mutable lambda is kept between calls
+	fun = [count = 0](int v) mutable { return v + ++count; };
+	EXPECT_EQ(fun(0), 1);
+	EXPECT_EQ(fun(0), 2);
+
+	// a null function pointer gives an empty function, like std::function
+	int (*none)(int) = nullptr;
+	fun = none;
+	EXPECT_FALSE(fun);
+
+	// arguments are forwarded, move-only ones included
+	cxpr::inplace_function<size_t(std::unique_ptr<std::string>)> take = [](std::unique_ptr<std::string> s) { return s->size(); };
+	EXPECT_EQ(take(std::make_unique<std::string>("abc")), 3);
+
+	static_assert(cxpr::inplace_function<void(), 16>::fits_v<void(*)()>, "function pointers fit");
+	static_assert(!cxpr::inplace_function<void(), 16>::fits_v<std::string>, "strings don't fit in 16 bytes");
+}
+
+TEST(inplace_function_tests, copy_move_test)
+{
+	auto shared = std::make_shared<int>(7);
+	cxpr::inplace_function<int()> a = [shared] { return *shared; };
+	EXPECT_EQ(shared.use_count(), 2);
+
+	cxpr::inplace_function<int()> b = a;
+	EXPECT_EQ(shared.use_count(), 3);
+	EXPECT_EQ(b(), 7);
+
+	cxpr::inplace_function<int()> c = std::move(a);
+	EXPECT_EQ(shared.use_count(), 3);
+	EXPECT_FALSE(a);
+	EXPECT_EQ(c(), 7);
+
+	b = nullptr;
+	EXPECT_EQ(shared.use_count(), 2);
+	c = [] { return 1; };
+	EXPECT_EQ(shared.use_count(), 1);
+	EXPECT_EQ(c(), 1);
+
+	// trivially copyable callables take the memcpy path
+	int value = 3;
+	cxpr::inplace_function<int()> by_ref = [&value] { return value; };
+	cxpr::inplace_function<int()> moved = std::move(by_ref);
+	value = 4;
+	EXPECT_EQ(moved(), 4);
+	EXPECT_FALSE(by_ref);
+}
+
+TEST(inplace_function_tests, container_test)
+{
+	// constant-initialized registry of empty callbacks
+	static cxpr::fixed_vector<cxpr::inplace_function<int(int)>, 4> registry;
+	EXPECT_EQ(registry.size(), 0);
+
+	registry.push_back(&twice);
+	registry.emplace_back([](int v) { return v - 1; });
+	EXPECT_EQ(registry[0](5), 10);
+	EXPECT_EQ(registry[1](5), 4);
+	registry.pop_back();
+	EXPECT_EQ(registry.size(), 1);
+
+	// not a literal type, so a map of handlers is built at run time
+	using handler_t = cxpr::inplace_function<int(int)>;
+	const auto handlers = cxpr::make_static_map<char, handler_t>(
+		{
+			{ 't', handler_t(&twice) },
+			{ 'a', handler_t(&add_one) },
+		});
+	EXPECT_EQ(handlers['t'](4), 8);
+	EXPECT_EQ(handlers['a'](4), 5);
+}
+
+TEST(inplace_function_tests, same_named_target_test)
+{	// GCC names both lambdas '<lambda(int)>' in this scope, so their typehash_v may be equal
+	auto twice_lambda = [](int v) { return v * 2; };
+	auto negate = [](int v) { return -v; };
+
+	cxpr::inplace_function<int(int)> fun = twice_lambda;
+	EXPECT_NE(fun.target<decltype(twice_lambda)>(), nullptr);
+	EXPECT_EQ(fun.target<decltype(negate)>(), nullptr);
+	EXPECT_EQ(std::as_const(fun).target<decltype(negate)>(), nullptr);
+}
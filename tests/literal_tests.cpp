@@ -0,0 +1,102 @@
+#include <iostream>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+TEST(literal_tests, construction_test)
+{
+	constexpr auto host = CXPR_LITERAL("Host");
+	using host_t = std::decay_t<decltype(host)>;
+
+	static_assert(std::is_same_v<host_t, cxpr::literal<'H', 'o', 's', 't'>>, "unexpected literal type");
+	static_assert(host_t::size() == 4, "unexpected size");
+	static_assert(host_t::view() == "Host", "unexpected contents");
+	static_assert(cxpr::is_literal_v<host_t>, "should be a literal");
+	static_assert(sizeof(host) == 1, "literal objects should be empty tags");
+
+	constexpr auto empty = CXPR_LITERAL("");
+	static_assert(decltype(empty)::empty() && decltype(empty)::view() == "", "empty literal failed");
+
+	EXPECT_STREQ(host.c_str(), "Host");
+	EXPECT_EQ(std::string_view(host), "Host");
+}
+
+TEST(literal_tests, operations_test)
+{
+	constexpr auto key = CXPR_LITERAL("Content");
+	constexpr auto suffix = CXPR_LITERAL("-Length");
+
+	// concat
+	constexpr auto joined = key + suffix;
+	static_assert(joined == CXPR_LITERAL("Content-Length"), "concat failed");
+	static_assert(joined != key, "concat failed");
+
+	// substr, clamped like std::string_view
+	static_assert(cxpr::substr<8>(joined) == CXPR_LITERAL("Length"), "substr failed");
+	static_assert(cxpr::substr<0, 3>(joined) == CXPR_LITERAL("Con"), "substr failed");
+	static_assert(cxpr::substr<10, 100>(joined) == CXPR_LITERAL("ngth"), "substr failed");
+	static_assert(cxpr::substr<14>(joined).empty(), "substr failed");
+
+	// case transforms are new types
+	static_assert(cxpr::to_lower(joined) == CXPR_LITERAL("content-length"), "to_lower failed");
+	constexpr auto upper = CXPR_LITERAL("CONTENT-LENGTH");
+	static_assert(std::is_same_v<decltype(joined)::upper_t, std::decay_t<decltype(upper)>>, "to_upper failed");
+
+	// find / starts_with / ends_with
+	static_assert(joined.find('-') == 7, "find failed");
+	static_assert(joined.find("Len") == 8, "find failed");
+	static_assert(joined.find('z') == cxpr::literal<>::npos, "find failed");
+	static_assert(joined.starts_with("Cont") && joined.ends_with("ngth"), "starts/ends_with failed");
+
+	// hash matches the runtime hash of the same text, and ignores case like hash_invariant
+	static_assert(decltype(joined)::hash == cxpr::hash_invariant("content-length"), "hash mismatch");
+	std::string runtime = "Content-Length";
+	EXPECT_EQ(decltype(joined)::hash, cxpr::hash_invariant(runtime));
+
+	// conversion to fixed_string
+	constexpr auto fixed = joined.to_fixed_string();
+	static_assert(sizeof(fixed) == 16, "unexpected fixed_string size");
+	EXPECT_EQ(fixed, "Content-Length");
+}
+
+template <typename literal_t>
+struct header_traits
+{
+	static constexpr bool is_length = false;
+};
+
+template <>
+struct header_traits<cxpr::literal<'c', 'o', 'n', 't', 'e', 'n', 't', '-', 'l', 'e', 'n', 'g', 't', 'h'>>
+{
+	static constexpr bool is_length = true;
+};
+
+TEST(literal_tests, specialization_and_lookup_test)
+{
+	// contents drive template specialization, lower_t normalizes case first
+	constexpr auto header = CXPR_LITERAL("Content-Length");
+	static_assert(header_traits<decltype(header)::lower_t>::is_length, "specialization failed");
+	constexpr auto host = CXPR_LITERAL("Host");
+	static_assert(!header_traits<std::decay_t<decltype(host)>>::is_length, "specialization failed");
+
+	// static_map keyed on hash_invariant can be queried with a literal and folds to a constant
+	constexpr static auto lut = cxpr::make_static_map<cxpr::hash_t, int>({
+		{ cxpr::hash_invariant("host"), 1 },
+		{ cxpr::hash_invariant("content-length"), 2 },
+		{ cxpr::hash_invariant("accept"), 3 },
+	});
+
+	if constexpr (lut.get_entry(CXPR_LITERAL("Content-Length")).first)
+	{
+		constexpr auto entry = lut.get_entry(CXPR_LITERAL("Content-Length"));
+		static_assert(*entry.second == 2, "lookup failed");
+	}
+	else
+	{
+		FAIL() << "compile-time lookup failed";
+	}
+
+	static_assert(lut.get_entry(CXPR_LITERAL("missing")).first == false, "lookup should miss");
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	using record_t = cxpr::packed_tuple<char, double, char, int>;
+}
+
+TEST(packed_tuple_tests, layout_test)
+{
+	static_assert(sizeof(record_t) == 16, "double, int, char, char");
+	static_assert(std::is_same_v<record_t::stored_types, cxpr::typeset<double, int, char, char>>, "stable sort by alignment");
+	static_assert(record_t::report.packed_bytes == sizeof(record_t), "report");
+	static_assert(record_t::report.tuple_bytes == sizeof(std::tuple<char, double, char, int>), "report");
+	static_assert(record_t::report.saved_bytes == record_t::report.tuple_bytes - 16, "report");
+	static_assert(record_t::report.padding_bytes == 2, "only the end is padded");
+
+	using sorted_t = cxpr::packed_tuple<double, int, char>;
+	static_assert(sorted_t::report.packed_bytes <= sorted_t::report.tuple_bytes, "never larger than std::tuple");
+	static_assert(std::is_same_v<std::tuple_element_t<1, record_t>, double> && std::tuple_size_v<record_t> == 4, "tuple traits");
+}
+
+TEST(packed_tuple_tests, access_test)
+{
+	record_t rec('a', 1.5, 'b', 7);
+	EXPECT_EQ(rec.get<0>(), 'a');
+	EXPECT_EQ(rec.get<1>(), 1.5);
+	EXPECT_EQ(rec.get<2>(), 'b');
+	EXPECT_EQ(cxpr::get<3>(rec), 7);
+
+	auto& [side, price, flag, qty] = rec;
+	price = 2.5;
+	qty++;
+	EXPECT_EQ(rec.get<1>(), 2.5);
+	EXPECT_EQ(rec.get<3>(), 8);
+	EXPECT_EQ(side, 'a');
+	EXPECT_EQ(flag, 'b');
+
+	EXPECT_EQ(rec.to_tuple(), std::make_tuple('a', 2.5, 'b', 8));
+	record_t copy = rec;
+	EXPECT_TRUE(copy == rec);
+	copy.get<2>() = 'c';
+	EXPECT_TRUE(copy != rec);
+
+	record_t empty;
+	EXPECT_EQ(empty.get<1>(), 0.0);
+	EXPECT_EQ(empty.get<3>(), 0);
+
+	constexpr record_t crec('x', 0.5, 'y', 3);
+	static_assert(crec.get<0>() == 'x' && crec.get<1>() == 0.5 && crec.get<3>() == 3, "usable during compile");
+}
+
+TEST(packed_tuple_tests, non_trivial_test)
+{
+	cxpr::packed_tuple<bool, std::string, uint16_t, std::string> rec(true, "first", 9, std::string(40, 'z'));
+	EXPECT_EQ(rec.get<1>(), "first");
+	EXPECT_EQ(rec.get<3>().size(), 40);
+
+	auto moved = std::move(rec);
+	EXPECT_EQ(moved.get<1>(), "first");
+	std::string taken = std::move(moved).get<3>();
+	EXPECT_EQ(taken.size(), 40);
+	EXPECT_TRUE(moved.get<0>());
+	EXPECT_EQ(moved.get<2>(), 9);
+}
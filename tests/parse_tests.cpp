@@ -0,0 +1,107 @@
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+TEST(parse_tests, integer_test)
+{
+	EXPECT_EQ(cxpr::parse<int>("0").value(), 0);
+	EXPECT_EQ(cxpr::parse<int>("-42").value(), -42);
+	EXPECT_EQ(cxpr::parse<uint64_t>("18446744073709551615").value(), 18446744073709551615ull);
+	EXPECT_EQ(cxpr::parse<int64_t>("-9223372036854775808").value(), std::numeric_limits<int64_t>::min());
+	EXPECT_EQ(cxpr::parse<int64_t>("000000000000000000000000000123").value(), 123);	// leading zeros don't overflow
+	EXPECT_EQ(cxpr::parse<int16_t>("1234567").has_value(), false);
+
+	int8_t small = 7;
+	EXPECT_EQ(cxpr::parse_to("128", small), std::errc::result_out_of_range);
+	EXPECT_EQ(cxpr::parse_to("-128", small), std::errc{});
+	EXPECT_EQ(small, -128);
+
+	unsigned sz = 5;
+	EXPECT_EQ(cxpr::parse_to("", sz), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("-1", sz), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("+1", sz), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("12 ", sz), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("123456789x", sz), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("99999999999999999999999x", sz), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("99999999999999999999999", sz), std::errc::result_out_of_range);
+	EXPECT_EQ(sz, 5);
+
+	// from fixed strings, no null terminator needed
+	const auto fields = cxpr::split<3>(std::string_view("17|1234567890123|-5"), '|');
+	EXPECT_EQ(cxpr::parse<int64_t>(fields[1]).value(), 1234567890123);
+	const auto fixed = cxpr::make_fixed_string("87654321");
+	EXPECT_EQ(cxpr::parse<uint32_t>(fixed).value(), 87654321u);
+
+	static_assert(cxpr::parse<int>("-2147483648").value() == std::numeric_limits<int>::min(), "compile-time parse failed");
+	static_assert(cxpr::parse<uint64_t>("1234567812345678").value() == 1234567812345678ull, "compile-time parse failed");
+}
+
+TEST(parse_tests, float_test)
+{
+	EXPECT_EQ(cxpr::parse<double>("12.25").value(), 12.25);
+	EXPECT_EQ(cxpr::parse<double>("-.5").value(), -0.5);
+	EXPECT_EQ(cxpr::parse<double>("5.").value(), 5.0);
+	EXPECT_EQ(cxpr::parse<double>("1E3").value(), 1000.0);
+	EXPECT_EQ(cxpr::parse<float>("3.4028235e38").value(), std::numeric_limits<float>::max());
+	EXPECT_TRUE(std::signbit(cxpr::parse<double>("-0e999").value()));
+	EXPECT_TRUE(std::isinf(cxpr::parse<double>("-Infinity").value()));
+	EXPECT_TRUE(std::isnan(cxpr::parse<double>("nan").value()));
+
+	double d = 1.0;
+	EXPECT_EQ(cxpr::parse_to("1e400", d), std::errc::result_out_of_range);
+	EXPECT_EQ(cxpr::parse_to("1e-400", d), std::errc::result_out_of_range);
+	EXPECT_EQ(cxpr::parse_to("", d), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to(".", d), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("1e", d), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("1e+", d), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("1.2.3", d), std::errc::invalid_argument);
+	EXPECT_EQ(cxpr::parse_to("+1", d), std::errc::invalid_argument);
+	EXPECT_EQ(d, 1.0);
+
+	// agrees with the standard library's correctly rounded conversion, including values the fast path can't handle
+	const char* samples[] = { "0.1", "0.30000000000000004", "9007199254740993", "123456789012345678901234567890",
+		"2.2250738585072011e-308", "4.9e-324", "1.7976931348623157e308", "0.000000000000000000000000000000000000001e39",
+		"3.141592653589793238462643383279", "7.038531e-26", "1448997445238699" };
+	for (const char* sample : samples)
+	{
+		const double expected = std::strtod(sample, nullptr);
+		const double parsed = cxpr::parse<double>(sample).value();
+		EXPECT_EQ(std::memcmp(&expected, &parsed, sizeof(double)), 0) << sample;
+
+		const float expectedF = std::strtof(sample, nullptr);
+		float parsedF = 0;
+		if (cxpr::parse_to(sample, parsedF) == std::errc{})
+		{
+			EXPECT_EQ(std::memcmp(&expectedF, &parsedF, sizeof(float)), 0) << sample;
+		}
+	}
+}
+
+TEST(parse_tests, constexpr_matches_runtime_test)
+{
+	// these miss the exact fast path, so compile and run time go through different conversions
+	static constexpr double compiled[] = {
+		cxpr::parse<double>("0.30000000000000004").value(),
+		cxpr::parse<double>("2.2250738585072011e-308").value(),
+		cxpr::parse<double>("4.9e-324").value(),
+		cxpr::parse<double>("123456789012345678901234567890").value(),
+		cxpr::parse<double>("3.141592653589793238462643383279").value(),
+	};
+	const char* text[] = { "0.30000000000000004", "2.2250738585072011e-308", "4.9e-324",
+		"123456789012345678901234567890", "3.141592653589793238462643383279" };
+
+	for (size_t i = 0; i < std::size(text); i++)
+	{
+		const double parsed = cxpr::parse<double>(text[i]).value();
+		EXPECT_EQ(std::memcmp(&compiled[i], &parsed, sizeof(double)), 0) << text[i];
+	}
+
+	static_assert(cxpr::parse<float>("0.1").value() == 0.1f, "compile-time float parse failed");
+	static_assert(cxpr::parse<double>("1e-400").has_value() == false, "compile-time underflow not reported");
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct small_msg { uint8_t code; };
+	struct medium_msg { uint32_t id; uint32_t flags; };
+	struct large_msg { char payload[64]; };
+}
+
+TEST(poly_collection_tests, insert_and_for_each_test)
+{
+	cxpr::poly_collection<cxpr::typeset<int, std::string, double>> items;
+	EXPECT_TRUE(items.empty());
+
+	items.insert(1);
+	items.insert(std::string("one"));
+	items.insert(2.5);
+	items.insert(2);
+	items.emplace<std::string>(3, 'x');
+
+	EXPECT_EQ(items.size(), 5);
+	EXPECT_EQ(items.size<int>(), 2);
+	EXPECT_EQ(items.segment<std::string>()[1], "xxx");
+
+	// type by type in typeset order, insertion order inside a type
+	std::string visited;
+	items.for_each([&](const auto& item)
+	{
+		if constexpr (std::is_same_v<std::decay_t<decltype(item)>, std::string>)
+		{
+			visited += item + ",";
+		}
+		else
+		{
+			visited += std::to_string(item).substr(0, 3) + ",";
+		}
+	});
+	EXPECT_EQ(visited, "1,2,one,xxx,2.5,");
+
+	// mutable access
+	items.for_each([](auto& item) { item = item + item; });
+	EXPECT_EQ(items.segment<int>()[1], 4);
+	EXPECT_EQ(items.segment<std::string>()[0], "oneone");
+
+	static_assert(decltype(items)::contains<const int&>, "types are decayed");
+	static_assert(!decltype(items)::contains<float>, "float is not part of the collection");
+
+	// variants land in the segment of the type they hold
+	std::variant<double, int> held = 7;
+	items.insert(held);
+	items.insert(std::variant<double, int>(0.5));
+	EXPECT_EQ(items.segment<int>().back(), 7);
+	EXPECT_EQ(items.segment<double>().back(), 0.5);
+
+	items.clear();
+	EXPECT_TRUE(items.empty());
+}
+
+TEST(poly_collection_tests, memory_test)
+{
+	using collection_t = cxpr::poly_collection<cxpr::typeset<small_msg, medium_msg, large_msg>>;
+	static_assert(collection_t::max_element_size == sizeof(large_msg), "largest type");
+	static_assert(collection_t::min_element_size == sizeof(small_msg), "smallest type");
+
+	collection_t messages;
+	for (int i = 0; i < 10; i++)
+	{
+		messages.insert(small_msg{ uint8_t(i) });
+		messages.insert(medium_msg{ uint32_t(i), 0 });
+	}
+	messages.insert(large_msg{});
+
+	EXPECT_EQ(messages.payload_bytes(), 10 * sizeof(small_msg) + 10 * sizeof(medium_msg) + sizeof(large_msg));
+	EXPECT_EQ(messages.variant_padding_bytes(), 21 * sizeof(large_msg) - messages.payload_bytes());
+}
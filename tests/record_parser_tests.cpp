@@ -0,0 +1,200 @@
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	constexpr auto sym = CXPR_LITERAL("sym");
+	constexpr auto px = CXPR_LITERAL("px");
+	constexpr auto qty = CXPR_LITERAL("qty");
+	constexpr auto live = CXPR_LITERAL("live");
+	constexpr auto venue = CXPR_LITERAL("venue");
+
+	using fill_schema = cxpr::record_schema<
+		cxpr::field<decltype(sym), cxpr::fixed_string<8>>,
+		cxpr::field<decltype(px), double>,
+		cxpr::field<decltype(qty), uint32_t>,
+		cxpr::field<decltype(live), bool>,
+		cxpr::field<decltype(venue), std::string_view>>;
+
+	// names around the 8 and 16 character boundaries of the key encoding
+	constexpr auto n8 = CXPR_LITERAL("exch_seq");
+	constexpr auto n9 = CXPR_LITERAL("exch_seqs");
+	constexpr auto n16 = CXPR_LITERAL("settlement_price");
+	constexpr auto n17 = CXPR_LITERAL("settlement_prices");
+	constexpr auto n1 = CXPR_LITERAL("x");
+
+	using boundary_schema = cxpr::record_schema<
+		cxpr::field<decltype(n8), uint32_t>,
+		cxpr::field<decltype(n9), uint32_t>,
+		cxpr::field<decltype(n16), double>,
+		cxpr::field<decltype(n17), double>,
+		cxpr::field<decltype(n1), int>>;
+
+	constexpr uint32_t parse_qty(std::string_view text)
+	{
+		fill_schema::tuple_t fill{};
+		return fill_schema::parse_kv(text, fill) ? fill_schema::get<decltype(qty)>(fill) : 0;
+	}
+
+	constexpr double parse_json_px(std::string_view text)
+	{
+		fill_schema::tuple_t fill{};
+		return fill_schema::parse_json(text, fill) ? std::get<1>(fill) : -1;
+	}
+}
+
+TEST(record_parser_tests, schema_test)
+{
+	static_assert(std::is_same_v<fill_schema::tuple_t, std::tuple<cxpr::fixed_string<8>, double, uint32_t, bool, std::string_view>>, "tuple");
+	static_assert(fill_schema::index_of<decltype(qty)> == 2, "declared order");
+	static_assert(fill_schema::contains<decltype(venue)>, "contains");
+	static_assert(!fill_schema::contains<cxpr::literal<'i', 'd'>>, "contains");
+
+	static_assert(fill_schema::find_index("px") == 1, "compile-time lookup");
+	EXPECT_EQ(fill_schema::find_index("sym"), 0u);
+	EXPECT_EQ(fill_schema::find_index("QTY"), 2u);	// case-insensitive
+	EXPECT_EQ(fill_schema::find_index("Venue"), 4u);
+	EXPECT_EQ(fill_schema::find_index("side"), fill_schema::npos);
+	EXPECT_EQ(fill_schema::find_index(""), fill_schema::npos);
+}
+
+TEST(record_parser_tests, boundary_test)
+{
+	EXPECT_EQ(boundary_schema::find_index("EXCH_SEQ"), 0u);
+	EXPECT_EQ(boundary_schema::find_index("exch_seqs"), 1u);
+	EXPECT_EQ(boundary_schema::find_index("exch_se"), boundary_schema::npos);
+	EXPECT_EQ(boundary_schema::find_index("exch_seqx"), boundary_schema::npos);
+	EXPECT_EQ(boundary_schema::find_index("Settlement_Price"), 2u);
+	EXPECT_EQ(boundary_schema::find_index("settlement_pricE"), 2u);
+	EXPECT_EQ(boundary_schema::find_index("settlement_prices"), 3u);
+	EXPECT_EQ(boundary_schema::find_index("settlement_pricex"), boundary_schema::npos);
+	EXPECT_EQ(boundary_schema::find_index("X"), 4u);
+	EXPECT_EQ(boundary_schema::find_index("y"), boundary_schema::npos);
+
+	// keys far from the end of the record and right at it take different paths, both must agree
+	boundary_schema::tuple_t row{};
+	const auto res = boundary_schema::parse_kv("x=-3;settlement_prices=2.5;EXCH_SEQS=9;settlement_price=1.5;exch_seq=8", row);
+	EXPECT_TRUE(res);
+	EXPECT_EQ(res.parsed, 5u);
+	EXPECT_EQ(row, boundary_schema::tuple_t(8, 9, 1.5, 2.5, -3));
+
+	const auto res2 = boundary_schema::parse_kv("exch_seq=1;exch_seqs=2;exch_seqz=3;x=4", row);
+	EXPECT_TRUE(res2);
+	EXPECT_EQ(res2.parsed, 3u);
+	EXPECT_EQ(res2.unknown, 1u);
+	EXPECT_EQ(row, boundary_schema::tuple_t(1, 2, 1.5, 2.5, 4));
+
+	// in order but spelled differently, the expected field only matches once the key is folded
+	const auto res3 = boundary_schema::parse_kv("EXCH_SEQ=5;Exch_Seqs=6;SETTLEMENT_PRICE=3.5;settlement_PRICES=4.5;X=7", row);
+	EXPECT_TRUE(res3);
+	EXPECT_EQ(res3.parsed, 5u);
+	EXPECT_EQ(row, boundary_schema::tuple_t(5, 6, 3.5, 4.5, 7));
+}
+
+TEST(record_parser_tests, kv_test)
+{
+	static_assert(parse_qty("sym=AAPL;qty=250") == 250, "usable during compile");
+
+	fill_schema::tuple_t fill{};
+	const auto res = fill_schema::parse_kv("sym=AAPL;px=187.25;;qty=100;live=true;venue=XNAS;side=B", fill);
+	EXPECT_TRUE(res);
+	EXPECT_EQ(res.parsed, 5u);
+	EXPECT_EQ(res.unknown, 1u);
+	EXPECT_EQ(fill_schema::get<decltype(sym)>(fill), "AAPL");
+	EXPECT_EQ(fill_schema::get<decltype(px)>(fill), 187.25);
+	EXPECT_EQ(fill_schema::get<decltype(qty)>(fill), 100u);
+	EXPECT_TRUE(fill_schema::get<decltype(live)>(fill));
+	EXPECT_EQ(fill_schema::get<decltype(venue)>(fill), "XNAS");
+
+	// other delimiters, fields that aren't present are left alone
+	const auto res2 = fill_schema::parse_kv("QTY:7|live:0", fill, '|', ':');
+	EXPECT_TRUE(res2);
+	EXPECT_EQ(res2.parsed, 2u);
+	EXPECT_EQ(std::get<2>(fill), 7u);
+	EXPECT_FALSE(std::get<3>(fill));
+	EXPECT_EQ(std::get<0>(fill), "AAPL");
+}
+
+TEST(record_parser_tests, kv_error_test)
+{
+	fill_schema::tuple_t fill{};
+	auto res = fill_schema::parse_kv("sym=AAPL;qty=12x;px=1", fill);
+	EXPECT_EQ(res.error, std::errc::invalid_argument);
+	EXPECT_EQ(res.field, 2u);
+	EXPECT_EQ(res.parsed, 1u);
+	EXPECT_EQ(std::get<2>(fill), 0u);	// untouched
+	EXPECT_EQ(std::get<1>(fill), 0.0);	// stopped before px
+
+	res = fill_schema::parse_kv("qty=99999999999", fill);
+	EXPECT_EQ(res.error, std::errc::result_out_of_range);
+
+	res = fill_schema::parse_kv("sym=TOOLONGSYM", fill);	// 7 chars fit
+	EXPECT_EQ(res.error, std::errc::result_out_of_range);
+	EXPECT_EQ(res.field, 0u);
+	EXPECT_EQ(std::get<0>(fill), "AAPL");
+
+	res = fill_schema::parse_kv("live=yes", fill);
+	EXPECT_EQ(res.error, std::errc::invalid_argument);
+
+	res = fill_schema::parse_kv("sym=AAPL;qty", fill);
+	EXPECT_EQ(res.error, std::errc::invalid_argument);
+	EXPECT_EQ(res.field, cxpr::record_parse_result::npos);
+}
+
+TEST(record_parser_tests, json_test)
+{
+	fill_schema::tuple_t fill{};
+	const auto res = fill_schema::parse_json(R"( { "sym": "MSFT", "px" : 411.5,"qty":"300", "live": false,
+		"venue": "ARCX", "side": "S", "note": null } )", fill);
+	EXPECT_TRUE(res);
+	EXPECT_EQ(res.parsed, 5u);
+	EXPECT_EQ(res.unknown, 1u);	// null values are skipped before the lookup
+	EXPECT_EQ(std::get<0>(fill), "MSFT");
+	EXPECT_EQ(std::get<1>(fill), 411.5);
+	EXPECT_EQ(std::get<2>(fill), 300u);
+	EXPECT_FALSE(std::get<3>(fill));
+	EXPECT_EQ(std::get<4>(fill), "ARCX");
+
+	static_assert(parse_qty("qty=1;QTY=2") == 2, "repeated fields keep the last value");
+	static_assert(parse_json_px(R"({"sym": "AAPL", "px": 12.5})") == 12.5, "usable during compile");
+
+	const auto empty = fill_schema::parse_json("{}", fill);
+	EXPECT_TRUE(empty);
+	EXPECT_EQ(empty.parsed, 0u);
+
+	const auto keep = fill_schema::parse_json(R"({"px": null})", fill);
+	EXPECT_TRUE(keep);
+	EXPECT_EQ(std::get<1>(fill), 411.5);
+}
+
+TEST(record_parser_tests, json_error_test)
+{
+	fill_schema::tuple_t fill{};
+	const std::string_view malformed[] = {
+		"",
+		"[]",
+		R"({"sym": "AAPL")",
+		R"({"sym" "AAPL"})",
+		R"({"sym": "AAPL",})",
+		R"({"sym": "AA\"PL"})",
+		R"({"px": 1.5} x)",
+		R"({"px": {"bid": 1}})",
+		R"({"px": [1]})",
+		R"({"px": })",
+		R"({sym: "AAPL"})",
+	};
+	for (auto text : malformed)
+	{
+		const auto res = fill_schema::parse_json(text, fill);
+		EXPECT_EQ(res.error, std::errc::invalid_argument) << text;
+		EXPECT_EQ(res.field, cxpr::record_parse_result::npos) << text;
+	}
+
+	const auto res = fill_schema::parse_json(R"({"qty": 1.5})", fill);
+	EXPECT_EQ(res.error, std::errc::invalid_argument);
+	EXPECT_EQ(res.field, 2u);
+}
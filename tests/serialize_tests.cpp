@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct quote
+	{
+		double bid;
+		double ask;
+	};
+
+	enum class side : uint8_t { buy, sell };
+
+	using fill_t = std::tuple<uint64_t, cxpr::fixed_string<8>, side, double, cxpr::fixed_vector<uint32_t, 4>>;
+
+	fill_t make_fill()
+	{
+		fill_t fill{ 42, cxpr::fixed_string<8>("XNAS"), side::sell, 101.25, cxpr::fixed_vector<uint32_t, 4>{} };
+		std::get<4>(fill).push_back(7);
+		std::get<4>(fill).push_back(9);
+		return fill;
+	}
+}
+
+TEST(serialize_tests, layout_test)
+{
+	// packed one after the other, strings and vectors take their whole capacity
+	static_assert(cxpr::serialized_size_v<uint16_t> == 2, "blob");
+	static_assert(cxpr::serialized_size_v<std::tuple<char, double, char>> == 10, "no padding");
+	static_assert(cxpr::serialized_size_v<cxpr::fixed_string<8>> == 4 + 7, "count + capacity");
+	static_assert(cxpr::serialized_size_v<cxpr::fixed_vector<uint32_t, 4>> == 4 + 16, "count + capacity");
+	static_assert(cxpr::serialized_size_v<fill_t> == 8 + 11 + 1 + 8 + 20, "fields add up");
+	static_assert(cxpr::serialized_size_v<std::pair<quote, std::array<int16_t, 3>>> == 16 + 6, "pairs and arrays");
+}
+
+TEST(serialize_tests, round_trip_test)
+{
+	const fill_t fill = make_fill();
+	const auto bytes = cxpr::serialize(fill);
+	static_assert(std::tuple_size_v<std::decay_t<decltype(bytes)>> == cxpr::serialized_size_v<fill_t>, "fixed size");
+
+	const auto copy = cxpr::deserialize<fill_t>(bytes.data(), bytes.size());
+	EXPECT_EQ(std::get<0>(copy), 42);
+	EXPECT_EQ(std::get<1>(copy), "XNAS");
+	EXPECT_EQ(std::get<2>(copy), side::sell);
+	EXPECT_EQ(std::get<3>(copy), 101.25);
+	ASSERT_EQ(std::get<4>(copy).size(), 2);
+	EXPECT_EQ(std::get<4>(copy)[1], 9);
+
+	// the same value always gives the same bytes, unused capacity is zeroed
+	EXPECT_EQ(cxpr::serialize(copy), bytes);
+
+	// nested tuples, packed_tuples and non-trivial vector elements
+	using nested_t = cxpr::packed_tuple<char, std::tuple<int, cxpr::fixed_string<4>>, cxpr::fixed_vector<cxpr::fixed_string<4>, 2>>;
+	nested_t nested('n', std::make_tuple(5, cxpr::fixed_string<4>("abc")), cxpr::fixed_vector<cxpr::fixed_string<4>, 2>{});
+	nested.get<2>().push_back(cxpr::fixed_string<4>("xy"));
+	std::vector<unsigned char> buffer(cxpr::serialized_size_v<nested_t> + 1);
+	EXPECT_EQ(cxpr::serialize(nested, buffer.data()), buffer.data() + cxpr::serialized_size_v<nested_t>);
+
+	nested_t out;
+	cxpr::deserialize(buffer.data(), buffer.size(), out);
+	EXPECT_EQ(out.get<0>(), 'n');
+	EXPECT_EQ(std::get<0>(out.get<1>()), 5);
+	EXPECT_EQ(std::get<1>(out.get<1>()), "abc");
+	ASSERT_EQ(out.get<2>().size(), 1);
+	EXPECT_EQ(out.get<2>()[0], "xy");
+
+	cxpr::wfixed_string<6> wide(L"wide");
+	const auto wide_bytes = cxpr::serialize(wide);
+	EXPECT_EQ(cxpr::deserialize<cxpr::wfixed_string<6>>(wide_bytes.data(), wide_bytes.size()), wide);
+}
+
+TEST(serialize_tests, large_capacity_test)
+{	// written straight into the buffer, a copy of the capacity on the stack would be 512 KiB here
+	using samples_t = cxpr::fixed_vector<double, 65536>;
+	auto samples = std::make_unique<samples_t>();
+	samples->push_back(1.5);
+	samples->push_back(-2.0);
+	std::vector<unsigned char> buffer(cxpr::serialized_size_v<samples_t>, 0xCD);
+	cxpr::serialize(*samples, buffer.data());
+	EXPECT_TRUE(std::all_of(buffer.begin() + 4 + 2 * sizeof(double), buffer.end(), [](unsigned char b) { return b == 0; }));
+
+	auto copy = std::make_unique<samples_t>();
+	cxpr::deserialize(buffer.data(), buffer.size(), *copy);
+	ASSERT_EQ(copy->size(), 2);
+	EXPECT_EQ((*copy)[1], -2.0);
+
+	cxpr::fixed_string<300> text("above the block limit");
+	const auto text_bytes = cxpr::serialize(text);
+	EXPECT_EQ(text_bytes.back(), 0);
+	EXPECT_EQ(cxpr::deserialize<cxpr::fixed_string<300>>(text_bytes.data(), text_bytes.size()), text);
+}
+
+TEST(serialize_tests, error_test)
+{
+	const auto bytes = cxpr::serialize(make_fill());
+	EXPECT_THROW(cxpr::deserialize<fill_t>(bytes.data(), bytes.size() - 1), std::out_of_range);
+	EXPECT_THROW((cxpr::serial_view<fill_t>(bytes.data(), 3)), std::out_of_range);
+
+	// a count larger than the capacity means the bytes aren't what we think they are
+	auto corrupt = bytes;
+	corrupt[8] = 200;
+	EXPECT_THROW(cxpr::deserialize<fill_t>(corrupt.data(), corrupt.size()), std::length_error);
+}
+
+TEST(serialize_tests, view_test)
+{
+	const auto bytes = cxpr::serialize(make_fill());
+	const cxpr::serial_view<fill_t> view(bytes.data(), bytes.size());
+
+	EXPECT_EQ(view.get<0>(), 42);
+	static_assert(std::is_same_v<decltype(view.get<1>()), std::string_view>, "strings are viewed in place");
+	EXPECT_EQ(view.get<1>(), "XNAS");
+	EXPECT_EQ(view.get<1>().data(), reinterpret_cast<const char*>(bytes.data() + 12));
+	EXPECT_EQ(view.get<2>(), side::sell);
+	EXPECT_EQ(view.get<3>(), 101.25);
+
+	const auto ids = view.get<4>();
+	ASSERT_EQ(ids.size(), 2);
+	EXPECT_EQ(ids[0], 7);
+	EXPECT_EQ(ids[1], 9);
+
+	EXPECT_EQ(std::get<1>(view.materialize()), "XNAS");
+
+	using outer_t = std::tuple<int16_t, fill_t>;
+	const auto outer_bytes = cxpr::serialize(outer_t(-3, make_fill()));
+	const cxpr::serial_view<outer_t> outer(outer_bytes.data(), outer_bytes.size());
+	EXPECT_EQ(outer.get<0>(), -3);
+	EXPECT_EQ(outer.get<1>().get<1>(), "XNAS");
+	EXPECT_EQ(outer.get<1>().get<4>()[1], 9);
+}
@@ -1,4 +1,6 @@
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include <cxpr.h>
@@ -271,4 +273,294 @@ TEST(fixed_string_tests, push_back)
 			}
 		}, std::runtime_error);
 	}
-}
\ No newline at end of file
+}
+TEST(fixed_string_tests, large_size_tracking)
+{
+	{	// sizes are tracked across the switch between the inline and extended remaining-capacity forms
+		auto ss1 = cxpr::fixed_string<1024>();
+		EXPECT_EQ(ss1.size(), 0);
+		for (size_t i = 0; i < large_data.size(); i++) {
+			ss1.push_back(large_data[i]);
+			EXPECT_EQ(ss1.size(), i + 1);
+			EXPECT_EQ(ss1.c_str()[i + 1], '\0');
+		}
+		EXPECT_EQ(ss1.size(), ss1.capacity());
+		EXPECT_EQ(ss1, large_data);
+	}
+
+	{	// shrinking from full back into the extended form
+		auto ss1 = cxpr::fixed_string<1024>(large_data);
+		ss1 = large_data.substr(0, 10);
+		EXPECT_EQ(ss1.size(), 10);
+		EXPECT_EQ(ss1, large_data.substr(0, 10));
+		ss1 = large_data.substr(0, 800);
+		EXPECT_EQ(ss1.size(), 800);
+		EXPECT_EQ(std::string(ss1.c_str()).size(), 800);
+	}
+
+	{	// everything past the string stays zeroed, so equal strings are bitwise equal
+		auto ss1 = cxpr::fixed_string<300>(large_data.substr(0, 100));
+		auto ss2 = cxpr::fixed_string<300>(large_data);
+		ss2 = large_data.substr(0, 100);
+		EXPECT_EQ(ss1.size(), ss2.size());
+		EXPECT_EQ(std::memcmp(&ss1, &ss2, sizeof(ss1)), 0);
+	}
+
+	{	// size is available at compile time
+		constexpr auto ss1 = cxpr::fixed_string<1024>(large_data_first_32);
+		static_assert(ss1.size() == large_data_first_32.size(), "unexpected size");
+		static_assert(sizeof(ss1) == 1024, "unexpected size, should be 1024 bytes");
+	}
+}
+
+TEST(fixed_string_tests, compare_and_search)
+{
+	{	// block compares agree with std::string_view for every split point
+		using str_t = cxpr::fixed_string<128>;
+		const auto source = large_data.substr(0, 127);
+		for (size_t i = 0; i <= source.size(); i++)
+		{
+			const str_t prefix(source.substr(0, i));
+			const str_t full(source);
+			EXPECT_EQ(prefix == full, i == source.size());
+			EXPECT_EQ(prefix != full, i != source.size());
+			EXPECT_EQ(prefix < full, source.substr(0, i) < source);
+			EXPECT_FALSE(full < prefix);
+			EXPECT_TRUE(full.starts_with(source.substr(0, i)));
+			EXPECT_EQ(prefix.starts_with(source), i == source.size());
+		}
+	}
+
+	{	// ordering looks at the first differing character, not the sizes
+		const auto ss1 = cxpr::fixed_string<64>(std::string_view("abcz"));
+		const auto ss2 = cxpr::fixed_string<64>(std::string_view("abd"));
+		EXPECT_TRUE(ss1 < ss2);
+		EXPECT_FALSE(ss2 < ss1);
+		EXPECT_TRUE(ss1 != ss2);
+	}
+
+	{	// embedded nulls still compare by size once the characters match
+		auto ss1 = cxpr::fixed_string<64>(std::string_view("ab"));
+		auto ss2 = ss1;
+		ss2.push_back('\0');
+		EXPECT_TRUE(ss1 < ss2);
+		EXPECT_FALSE(ss2 < ss1);
+		EXPECT_FALSE(ss1 == ss2);
+	}
+
+	{	// find/starts_with agree with std::string_view
+		const auto source = large_data.substr(0, 127);
+		const auto ss = cxpr::fixed_string<128>(source);
+		for (char ch : std::string_view("LoremZ,. tq"))
+		{
+			EXPECT_EQ(ss.find(ch), source.find(ch));
+			EXPECT_EQ(ss.find(ch, 20), source.find(ch, 20));
+		}
+
+		for (auto needle : { "Lorem", "amet", "elit. Aenean", "ligula", "dolor", "xyz", "Aenean commodo", "" })
+		{
+			EXPECT_EQ(ss.find(std::string_view(needle)), source.find(needle));
+			EXPECT_EQ(ss.find(std::string_view(needle), 30), source.find(needle, 30));
+		}
+		EXPECT_EQ(ss.find(source), 0);
+		EXPECT_EQ(ss.find('L', 500), ss.npos);
+	}
+
+	{	// the constexpr fallback gives the same answers
+		constexpr auto ss1 = cxpr::fixed_string<64>(large_data_first_32);
+		constexpr auto ss2 = cxpr::fixed_string<64>(large_data_first_32.substr(0, 20));
+		static_assert(ss2 < ss1, "compile-time compare failed");
+		static_assert(!(ss1 == ss2), "compile-time compare failed");
+		static_assert(ss1.starts_with("Lorem"), "compile-time starts_with failed");
+		static_assert(ss1.find('d') == large_data_first_32.find('d'), "compile-time find failed");
+		static_assert(ss1.find("sit") == large_data_first_32.find("sit"), "compile-time find failed");
+
+		const auto rt1 = ss1;
+		const auto rt2 = ss2;
+		EXPECT_EQ(rt2 < rt1, ss2 < ss1);
+		EXPECT_EQ(rt1.find("sit"), ss1.find("sit"));
+	}
+}
+
+// compile-time hashes of every prefix of large_data up to 'count' characters
+template <size_t count>
+constexpr std::array<cxpr::hash_t, count + 1> prefix_hashes()
+{
+	std::array<cxpr::hash_t, count + 1> out{};
+	for (size_t i = 0; i <= count; i++)
+	{
+		out[i] = cxpr::hash_invariant(large_data.substr(0, i));
+	}
+	return out;
+}
+
+TEST(fixed_string_tests, hashing)
+{
+	{	// compile-time and run-time hashes match, for every length class of the hash
+		using namespace cxpr;
+		constexpr auto ct_short = "foo"_hash;
+		constexpr auto ct_mid = "header-name"_hash;
+		constexpr auto ct_long = cxpr::hash_invariant(large_data);
+		static_assert(ct_short != ct_mid, "hashes should differ");
+
+		std::string rt_short = "foo";
+		std::string rt_mid = "header-name";
+		std::string rt_long(large_data);
+		EXPECT_EQ(ct_short, cxpr::hash_invariant(rt_short));
+		EXPECT_EQ(ct_mid, cxpr::hash_invariant(rt_mid));
+		EXPECT_EQ(ct_long, cxpr::hash_invariant(rt_long));
+		EXPECT_EQ(ct_mid, cxpr::fixed_string<32>(rt_mid).hash());
+	}
+
+	{	// run-time reads are plain loads, they must agree with the compile-time byte loop for every tail length
+		static constexpr auto ct_prefixes = prefix_hashes<40>();
+		const std::string rt_data(large_data);
+		for (size_t i = 0; i < ct_prefixes.size(); i++)
+		{
+			EXPECT_EQ(ct_prefixes[i], cxpr::hash_invariant(std::string_view(rt_data).substr(0, i))) << i;
+		}
+	}
+
+	{	// hashes are case-invariant, and every prefix of the data hashes differently
+		EXPECT_EQ(cxpr::hash_invariant("Content-Type"), cxpr::hash_invariant("content-type"));
+		EXPECT_EQ(cxpr::hash_invariant(large_data), cxpr::hash_invariant(std::string_view(cxpr::to_lower<std::string>(large_data))));
+
+		std::vector<cxpr::hash_t> hashes;
+		for (size_t i = 0; i <= 200; i++)
+		{
+			hashes.push_back(cxpr::hash_invariant(large_data.substr(0, i)));
+		}
+		std::sort(hashes.begin(), hashes.end());
+		EXPECT_EQ(std::unique(hashes.begin(), hashes.end()), hashes.end());
+	}
+
+	{	// cached hash
+		using str_t = cxpr::hashed_fixed_string<64>;
+		constexpr str_t ss1(std::string_view("x-request-id"));
+		static_assert(ss1.hash() == cxpr::hash_invariant("x-request-id"), "cached hash mismatch");
+
+		str_t ss2;
+		EXPECT_NE(ss1, ss2);
+		ss2 = std::string_view("x-request-id");
+		EXPECT_EQ(ss1, ss2);
+		EXPECT_EQ(ss1.hash(), ss2.hash());
+		EXPECT_EQ(ss2, "x-request-id");
+
+		// same hash, different case, must still compare unequal
+		const str_t ss3(std::string_view("X-Request-Id"));
+		EXPECT_EQ(ss1.hash(), ss3.hash());
+		EXPECT_NE(ss1, ss3);
+	}
+}
+
+TEST(fixed_string_tests, append_and_format)
+{
+	{	// integers
+		cxpr::fixed_string<128> ss;
+		ss.append(0).append(' ').append(7).append(' ').append(-42).append(' ').append(1234567890123ull);
+		ss.append(' ').append(std::numeric_limits<int64_t>::min()).append(' ').append(std::numeric_limits<uint64_t>::max());
+		EXPECT_EQ(ss, "0 7 -42 1234567890123 -9223372036854775808 18446744073709551615");
+
+		for (int64_t v : { 1ll, 9ll, 10ll, 99ll, 100ll, 101ll, 999ll, 1000ll, -1ll, -10ll, 123456789ll })
+		{
+			cxpr::fixed_string<32> num;
+			num.append(v);
+			EXPECT_EQ(num, std::to_string(v));
+		}
+	}
+
+	{	// floats
+		cxpr::fixed_string<64> ss;
+		ss.append(1.5).append(' ').append(-0.1f).append(' ').append(3.14159, std::chars_format::fixed, 2);
+		EXPECT_EQ(ss, "1.5 -0.1 3.14");
+	}
+
+	{	// strings and other fixed strings
+		const auto name = cxpr::make_fixed_string("latency");
+		cxpr::fixed_string<64> ss;
+		ss.append("metric.").append(name).append(std::string("_ms"));
+		EXPECT_EQ(ss, "metric.latency_ms");
+	}
+
+	{	// format_to
+		cxpr::fixed_string<64> ss;
+		cxpr::format_to(ss, "shard_", 3, "_p99=", 12.25, "ms");
+		EXPECT_EQ(ss, "shard_3_p99=12.25ms");
+
+		constexpr auto label = []() constexpr
+		{
+			cxpr::fixed_string<32> out;
+			cxpr::format_to(out, "id:", -17, '/', 250u);
+			return out;
+		}();
+		static_assert(label == std::string_view("id:-17/250"), "compile-time format failed");
+	}
+
+	{	// transforms apply to appended text
+		cxpr::fixed_string<32, cxpr::upper_case> ss;
+		ss.append("level=").append(1e20);
+		EXPECT_EQ(ss, "LEVEL=1E+20");
+	}
+
+	{	// truncate vs throw
+		cxpr::fixed_string<8> trunc;
+		trunc.append("count=").append(123456);
+		EXPECT_EQ(trunc, "count=1");
+
+		cxpr::fixed_string<8, cxpr::no_transform, cxpr::overrun_behavior_throw> thrower;
+		thrower.append("count=");
+		EXPECT_THROW(thrower.append(123456), std::runtime_error);
+		EXPECT_EQ(thrower, "count=");
+		thrower.append(1);
+		EXPECT_EQ(thrower, "count=1");
+	}
+
+	{	// wide strings widen the formatted digits
+		cxpr::wfixed_string<32> ss;
+		ss.append(L"v=").append(-250);
+		EXPECT_EQ(ss, std::wstring_view(L"v=-250"));
+	}
+}
+
+TEST(fixed_string_tests, case_folding)
+{
+	// long enough to go through the vector loops, with non-ASCII bytes that must be left alone
+	std::string mixed;
+	for (int i = 0; i < 300; i++)
+	{
+		mixed.push_back(static_cast<char>(i & 0xFF ? i & 0xFF : 'Q'));
+	}
+
+	std::string expectLower = mixed;
+	std::string expectUpper = mixed;
+	for (auto& ch : expectLower) { ch = cxpr::cx_tolower(ch); }
+	for (auto& ch : expectUpper) { ch = cxpr::cx_toupper(ch); }
+
+	{	// transforms
+		cxpr::fixed_string<512, cxpr::lower_case> lower(mixed);
+		cxpr::fixed_string<512, cxpr::upper_case> upper(mixed);
+		EXPECT_EQ(std::string_view(lower), expectLower);
+		EXPECT_EQ(std::string_view(upper), expectUpper);
+
+		lower.append("TAIL");
+		EXPECT_TRUE(std::string_view(lower).substr(300) == "tail");
+	}
+
+	{	// in place
+		std::string str = mixed;
+		cxpr::to_lower_inplace(str);
+		EXPECT_EQ(str, expectLower);
+		cxpr::to_upper_inplace(str);
+		EXPECT_EQ(str, expectUpper);
+
+		cxpr::fixed_string<512> fixed(mixed);
+		cxpr::to_lower_inplace(fixed);
+		EXPECT_EQ(std::string_view(fixed), expectLower);
+		EXPECT_EQ(fixed.size(), mixed.size());
+	}
+
+	{	// compile-time
+		constexpr cxpr::fixed_string<32, cxpr::upper_case> upper(std::string_view("Content-Length"));
+		static_assert(upper == std::string_view("CONTENT-LENGTH"), "compile-time case transform failed");
+	}
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+TEST(string_interner_tests, literal_registry_test)
+{
+	constexpr auto tags = cxpr::make_literal_registry({ "host", "user-agent", "accept", "content-length" });
+
+	// ids are the literal's position and resolve during compile
+	constexpr auto accept_id = tags.id_of("accept");
+	static_assert(accept_id == cxpr::interned_id{ 2 }, "unexpected literal id");
+	static_assert(tags.get_entry("host").first, "literal should be registered");
+	static_assert(tags.get_entry("missing").first == false, "literal should not be registered");
+
+	if constexpr (tags.get_entry<cxpr::hash_invariant("user-agent")>().first)
+	{
+		EXPECT_EQ(tags.get_entry<cxpr::hash_invariant("user-agent")>().second->value, 1u);
+	}
+	else
+	{
+		FAIL() << "compile-time lookup failed";
+	}
+
+	// run-time lookups agree, and case differences don't match
+	const std::string runtime_name = "content-length";
+	EXPECT_EQ(tags.get_entry(runtime_name).second, cxpr::interned_id{ 3 });
+	EXPECT_FALSE(tags.get_entry("Content-Length").first);
+	EXPECT_EQ(tags.str(accept_id), "accept");
+	EXPECT_THROW((void)tags.id_of("nope"), std::runtime_error);
+}
+
+TEST(string_interner_tests, intern_test)
+{
+	constexpr auto tags = cxpr::make_literal_registry({ "host", "user-agent", "accept" });
+	auto interner = std::make_unique<cxpr::string_interner<64, 32>>(tags);
+
+	{	// pre-registered literals keep their compile-time ids
+		EXPECT_EQ(interner->size(), tags.size());
+		EXPECT_EQ(interner->intern("accept"), tags.id_of("accept"));
+		EXPECT_EQ(interner->find(std::string("host")).second, tags.id_of("host"));
+	}
+
+	{	// new strings get the next dense id, repeats return the same one
+		const auto a = interner->intern("x-request-id");
+		const auto b = interner->intern("X-Request-Id"); // same case-invariant hash, different string
+		EXPECT_EQ(a, cxpr::interned_id{ 3 });
+		EXPECT_EQ(b, cxpr::interned_id{ 4 });
+		EXPECT_EQ(interner->intern(std::string("x-request-id")), a);
+		EXPECT_EQ(interner->str(b), "X-Request-Id");
+		EXPECT_FALSE(interner->find("unknown").first);
+	}
+
+	{	// capacity limits throw
+		EXPECT_THROW(interner->intern("this string is far too long for the interner"), std::runtime_error);
+
+		cxpr::string_interner<2, 16> tiny;
+		tiny.intern("a");
+		tiny.intern("b");
+		EXPECT_THROW(tiny.intern("c"), std::runtime_error);
+		EXPECT_EQ(tiny.intern("a"), cxpr::interned_id{ 0 });
+	}
+}
+
+TEST(string_interner_tests, concurrent_intern_test)
+{
+	// every thread interns the same names in a different order, all must agree on the ids
+	auto interner = std::make_unique<cxpr::string_interner<512, 32>>();
+	constexpr size_t thread_count = 4;
+	constexpr size_t name_count = 400;
+
+	std::vector<std::vector<cxpr::interned_id>> results(thread_count, std::vector<cxpr::interned_id>(name_count));
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < thread_count; t++)
+	{
+		threads.emplace_back([&, t]()
+		{
+			for (size_t i = 0; i < name_count; i++)
+			{
+				const size_t idx = (t % 2 == 0) ? i : name_count - 1 - i;
+				results[t][idx] = interner->intern("tag_" + std::to_string(idx));
+			}
+		});
+	}
+	for (auto& it : threads)
+	{
+		it.join();
+	}
+
+	EXPECT_EQ(interner->size(), name_count);
+	for (size_t i = 0; i < name_count; i++)
+	{
+		for (size_t t = 1; t < thread_count; t++)
+		{
+			EXPECT_EQ(results[0][i], results[t][i]);
+		}
+		EXPECT_EQ(interner->str(results[0][i]), "tag_" + std::to_string(i));
+	}
+}
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+TEST(string_utils_tests, split_test)
+{
+	{	// basic, empty fields are kept
+		const std::string line = "id,name,,value,";
+		const auto fields = cxpr::split<8>(line, ',');
+		ASSERT_EQ(fields.size(), 5);
+		EXPECT_EQ(fields[0], "id");
+		EXPECT_EQ(fields[1], "name");
+		EXPECT_EQ(fields[2], "");
+		EXPECT_EQ(fields[3], "value");
+		EXPECT_EQ(fields[4], "");
+
+		// views point into the source, nothing was copied
+		EXPECT_EQ(fields[0].data(), line.data());
+		EXPECT_EQ(fields[3].data(), line.data() + 9);
+	}
+
+	{	// multi-character delimiter
+		const auto fields = cxpr::split<4>(std::string_view("key1::key2::::key3"), "::");
+		ASSERT_EQ(fields.size(), 4);
+		EXPECT_EQ(fields[0], "key1");
+		EXPECT_EQ(fields[1], "key2");
+		EXPECT_EQ(fields[2], "");
+		EXPECT_EQ(fields[3], "key3");
+	}
+
+	{	// fixed_string source, long enough to go through the vector scan
+		const auto line = cxpr::fixed_string<256>(std::string_view(
+			"a fairly long field without any separators in it at all|second field|third field that is also long enough"));
+		const auto fields = cxpr::split<4>(line, '|');
+		ASSERT_EQ(fields.size(), 3);
+		EXPECT_EQ(fields[1], "second field");
+		EXPECT_EQ(fields[2], "third field that is also long enough");
+	}
+
+	{	// truncate drops extra fields, throw throws
+		const auto fields = cxpr::split<2>("a b c", ' ');
+		ASSERT_EQ(fields.size(), 2);
+		EXPECT_EQ(fields[1], "b");
+
+		EXPECT_THROW((cxpr::split<2, cxpr::overrun_behavior_throw>("a b c", ' ')), std::runtime_error);
+	}
+
+	{	// no delimiter or an empty delimiter yields the source
+		const auto fields = cxpr::split<2>("abc", ';');
+		ASSERT_EQ(fields.size(), 1);
+		EXPECT_EQ(fields[0], "abc");
+
+		const auto empty_delim = cxpr::split<2>("abc", "");
+		ASSERT_EQ(empty_delim.size(), 1);
+		EXPECT_EQ(empty_delim[0], "abc");
+	}
+}
+
+TEST(string_utils_tests, tokenize_test)
+{
+	{	// runs of delimiters collapse
+		const auto tokens = cxpr::tokenize<8>("  GET   /index.html  HTTP/1.1 ", ' ');
+		ASSERT_EQ(tokens.size(), 3);
+		EXPECT_EQ(tokens[0], "GET");
+		EXPECT_EQ(tokens[1], "/index.html");
+		EXPECT_EQ(tokens[2], "HTTP/1.1");
+	}
+
+	{	// range-for over a splitter
+		std::vector<std::string> collected;
+		for (auto token : cxpr::make_splitter(std::string_view("x=1;y=2;;z=3"), ';', true))
+		{
+			collected.emplace_back(token);
+		}
+		EXPECT_EQ(collected, std::vector<std::string>({ "x=1", "y=2", "z=3" }));
+	}
+
+	{	// wide strings
+		const auto tokens = cxpr::split<4>(std::wstring_view(L"one,two"), L',');
+		ASSERT_EQ(tokens.size(), 2);
+		EXPECT_EQ(tokens[1], L"two");
+	}
+}
+
+TEST(string_utils_tests, constexpr_split_test)
+{
+	// tables can be parsed from literals at compile-time
+	constexpr auto fields = cxpr::split<4>("alpha|beta|gamma", '|');
+	static_assert(fields.size() == 3, "compile-time split failed");
+	static_assert(fields[0] == "alpha", "compile-time split failed");
+	static_assert(fields[2] == "gamma", "compile-time split failed");
+
+	constexpr auto tokens = cxpr::tokenize<4>("  a  bb ", " ");
+	static_assert(tokens.size() == 2 && tokens[1] == "bb", "compile-time tokenize failed");
+
+	// same answers at run-time
+	const std::string source = "alpha|beta|gamma";
+	const auto rt_fields = cxpr::split<4>(source, '|');
+	ASSERT_EQ(rt_fields.size(), fields.size());
+	for (size_t i = 0; i < fields.size(); i++)
+	{
+		EXPECT_EQ(rt_fields[i], fields[i]);
+	}
+}
+
+TEST(string_utils_tests, case_insensitive_compare_test)
+{
+	EXPECT_TRUE(cxpr::iequals(std::string("Content-Length"), "content-LENGTH"));
+	EXPECT_FALSE(cxpr::iequals(std::string_view("Content-Length"), "content-length "));
+	EXPECT_FALSE(cxpr::iequals(std::string_view("Content-Length"), "Content_Length"));
+	EXPECT_TRUE(cxpr::iequals(cxpr::make_fixed_string("ACCEPT"), std::string_view("accept")));
+
+	// letters only, '@' and '`' sit just outside the A-Z/a-z ranges
+	EXPECT_FALSE(cxpr::iequals(std::string_view("@"), "`"));
+
+	// mismatches in and past the vector blocks
+	std::string l(100, 'A');
+	std::string r(100, 'a');
+	EXPECT_TRUE(cxpr::iequals(l, r));
+	EXPECT_EQ(cxpr::icompare(l, r), 0);
+	r[70] = 'c';
+	EXPECT_FALSE(cxpr::iequals(l, r));
+	EXPECT_LT(cxpr::icompare(l, r), 0);
+	EXPECT_GT(cxpr::icompare(r, l), 0);
+
+	EXPECT_LT(cxpr::icompare(std::string_view("abc"), "ABCD"), 0);
+	EXPECT_GT(cxpr::icompare(std::string_view("abd"), "ABCD"), 0);
+	// ordering is on the lowercased characters, so '[' sorts before 'A' even though it's above 'Z'
+	EXPECT_LT(cxpr::icompare(std::string_view("["), "A"), 0);
+
+	static_assert(cxpr::iequals(std::string_view("Host"), "HOST"), "compile-time iequals failed");
+	static_assert(cxpr::icompare(std::string_view("host"), "HOSTS") < 0, "compile-time icompare failed");
+}
@@ -1,4 +1,8 @@
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <string>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include <cxpr.h>
@@ -90,6 +94,102 @@ TEST(tuple_tests, visit_tuple_pack_test)
 	}
 }
 
+TEST(tuple_tests, visit_tuple_capture_test)
+{
+	std::tuple<int, double, std::string> tt(10, 1.5, "abc");
+
+	auto sizes = cxpr::visit_tuple_capture([](const auto& v) { return sizeof(v); }, tt);
+	static_assert(std::is_same_v<decltype(sizes), std::tuple<size_t, size_t, size_t>>, "results are kept by value");
+	EXPECT_EQ(std::get<2>(sizes), sizeof(std::string));
+
+	auto refs = cxpr::visit_tuple_capture([](auto& v) -> decltype(auto) { return v; }, tt);
+	static_assert(std::is_same_v<decltype(refs), std::tuple<int&, double&, std::string&>>, "references are kept");
+	std::get<0>(refs) = 20;
+	EXPECT_EQ(std::get<0>(tt), 20);
+
+	std::string order;
+	cxpr::visit_tuple_capture([&](const auto& v) { order += std::to_string(sizeof(v)); return 0; }, std::tuple<char, int16_t, int32_t>{});
+	EXPECT_EQ(order, "124");
+
+	constexpr auto doubled = cxpr::visit_tuple_capture([](auto v) { return v * 2; }, std::tuple<int, long>(3, 4));
+	static_assert(std::get<0>(doubled) == 6 && std::get<1>(doubled) == 8, "usable during compile");
+}
+
+TEST(tuple_tests, tuple_at_test)
+{
+	std::tuple<int, double, float> tt(10, 1.5, 2.0f);
+
+	auto as_double = [](auto v) { return double(v); };
+	static_assert(std::is_same_v<decltype(cxpr::tuple_at(tt, 0, as_double)), double>, "common type");
+	EXPECT_EQ(cxpr::tuple_at(tt, 0, as_double), 10.0);
+	EXPECT_EQ(cxpr::tuple_at(tt, 1, as_double), 1.5);
+	EXPECT_EQ(cxpr::tuple_at(tt, 2, as_double), 2.0);
+	EXPECT_THROW(cxpr::tuple_at(tt, 3, as_double), std::out_of_range);
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		cxpr::tuple_at(tt, i, [](auto& v) { v += 1; });
+	}
+	EXPECT_EQ(std::get<0>(tt), 11);
+	EXPECT_EQ(std::get<2>(tt), 3.0f);
+
+	std::tuple<int, int> same(1, 2);
+	cxpr::tuple_at(same, 1, [](int& v) -> int& { return v; }) = 7; // one result type keeps the reference
+	EXPECT_EQ(std::get<1>(same), 7);
+
+	constexpr std::tuple<int, long> ctt(3, 4);
+	static_assert(cxpr::tuple_at(ctt, 1, [](auto v) { return long(v); }) == 4, "usable during compile");
+}
+
+TEST(tuple_tests, parallel_visit_tuple_test)
+{
+	auto run_async = [](auto task) { return std::async(std::launch::async, task); };
+
+	std::tuple<std::vector<int>, std::vector<int>, std::vector<int>> shards;
+	cxpr::parallel_visit_tuple([](auto& shard)
+	{
+		for (int i = 0; i < 1000; i++)
+		{
+			shard.push_back(i);
+		}
+	}, shards, run_async);
+	cxpr::visit_tuple([](const auto& shard) { EXPECT_EQ(shard.size(), 1000); }, shards);
+
+	// every task finishes before the first failure is rethrown
+	std::tuple<int, int, int> flushed{};
+	EXPECT_THROW(cxpr::parallel_visit_tuple([](int& v)
+	{
+		v = 1;
+		throw std::runtime_error("flush failed");
+	}, flushed, run_async), std::runtime_error);
+	EXPECT_EQ(std::get<0>(flushed) + std::get<1>(flushed) + std::get<2>(flushed), 3);
+
+	// an executor that fails on its third submit, its futures don't wait for the task when destroyed
+	size_t submitted = 0;
+	auto run_detached = [&submitted](auto task)
+	{
+		if (++submitted == 3)
+		{
+			throw std::runtime_error("executor is full");
+		}
+		std::packaged_task<void()> job(task);
+		auto done = job.get_future();
+		std::thread(std::move(job)).detach();
+		return done;
+	};
+
+	// the tasks that did start are done before the exception leaves
+	std::tuple<int, int, int> slow{};
+	EXPECT_THROW(cxpr::parallel_visit_tuple([](int& v)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		v = 1;
+	}, slow, run_detached), std::runtime_error);
+	EXPECT_EQ(submitted, 3);
+	EXPECT_EQ(std::get<0>(slow) + std::get<1>(slow), 2);
+	EXPECT_EQ(std::get<2>(slow), 0);
+}
+
 template <typename inner_t>
 struct mutator_test
 {
@@ -144,3 +244,34 @@ TEST(tuple_tests, unique_type_test)
 
 //////////////////////////////////////////////////////////////////////////
 
+
+TEST(tuple_tests, typeset_algorithm_test)
+{
+	// everything below should just fail to compile if the test 'fails'
+	using set_t = cxpr::typeset<char, double, int, char, std::string, int16_t, double>;
+
+	static_assert(std::is_same_v<cxpr::typeset_element_t<4, set_t>, std::string>, "element");
+	static_assert(cxpr::typeset_index_of_v<double, set_t> == 1, "first match");
+	static_assert(cxpr::typeset_index_of_v<float, set_t> == 7, "no match is the size");
+	static_assert(cxpr::typeset_index_of_v<int, std::tuple<int&, int>> == 1, "exact match");
+	static_assert(cxpr::typeset_contains_v<int16_t, set_t> && !cxpr::typeset_contains_v<float, set_t>, "contains");
+
+	static_assert(std::is_same_v<cxpr::typeset_filter_t<set_t, std::is_integral>, cxpr::typeset<char, int, char, int16_t>>, "filter");
+	static_assert(std::is_same_v<cxpr::typeset_filter_t<cxpr::typeset<>, std::is_integral>, cxpr::typeset<>>, "empty filter");
+
+	using split_t = cxpr::typeset_partition<set_t, std::is_floating_point>;
+	static_assert(std::is_same_v<split_t::matching, cxpr::typeset<double, double>>, "partition");
+	static_assert(std::is_same_v<split_t::rest, cxpr::typeset<char, int, char, std::string, int16_t>>, "partition");
+
+	static_assert(std::is_same_v<cxpr::typeset_unique_t<set_t>, cxpr::typeset<char, double, int, std::string, int16_t>>, "unique");
+	static_assert(std::is_same_v<cxpr::typeset_unique_t<std::tuple<int, int&, int>>, cxpr::typeset<int, int&>>, "exact unique");
+	static_assert(std::is_same_v<cxpr::unique_types_t<int, int&, const int>, cxpr::typeset<int>>, "decaying unique");
+
+	static_assert(std::is_same_v<cxpr::typeset_sort_by_size_t<cxpr::typeset<char, double, int16_t, int64_t, char>>,
+		cxpr::typeset<double, int64_t, int16_t, char, char>>, "stable sort by size");
+
+	static_assert(std::is_same_v<cxpr::typeset_concat_t<cxpr::typeset<int>, std::tuple<>, std::tuple<char, double>, cxpr::typeset<int>>,
+		cxpr::typeset<int, char, double, int>>, "concat");
+	static_assert(std::is_same_v<cxpr::typeset_concat_t<>, cxpr::typeset<>>, "empty concat");
+	static_assert(std::is_same_v<cxpr::collapse_tuples_t<std::tuple<int>, cxpr::typeset<float, char>>, cxpr::typeset<int, float, char>>, "collapse");
+}
@@ -32,4 +32,41 @@ TEST(typehash_tests, uniqueness_test)
 		EXPECT_EQ(hashes[0], hashes[1]);
 		EXPECT_EQ(hashes[0], hashes[2]);
 	}
-}
\ No newline at end of file
+}
+
+namespace
+{
+	struct local_message {};
+	template <typename T> struct wrapper {};
+}
+
+TEST(typehash_tests, type_name_test)
+{
+	static_assert(cxpr::type_name_v<int> == "int", "type name should be trimmed to the bare type");
+	static_assert(cxpr::type_name_v<double> == "double", "type name should be trimmed to the bare type");
+	EXPECT_NE(cxpr::type_name_v<local_message>.find("local_message"), std::string_view::npos);
+	EXPECT_NE(cxpr::type_name_v<wrapper<local_message>>.find("wrapper<"), std::string_view::npos);
+	EXPECT_EQ(cxpr::type_name_v<wrapper<local_message>>.back(), '>');
+
+	// the hash uses all 64 bits
+	static_assert((cxpr::typehash_v<int> >> 32) != 0 || (cxpr::typehash_v<float> >> 32) != 0, "hash should be 64 bits wide");
+	static_assert(cxpr::typehash_v<int> == cxpr::hash_typename("int"), "hash should be of the bare name");
+}
+
+TEST(typehash_tests, unique_typehashes_test)
+{
+	using message_types_t = cxpr::typeset<int, unsigned, long, unsigned long, float, double, char, std::string,
+		local_message, wrapper<int>, wrapper<local_message>, wrapper<wrapper<int>>>;
+	static_assert(cxpr::assert_unique_typehashes<message_types_t>(), "");
+	static_assert(cxpr::unique_typehashes_v<std::tuple<int, float>>, "tuples are type sets too");
+	static_assert(cxpr::unique_typehashes_v<cxpr::typeset<int, const int&>> == false, "decayed duplicates collide");
+	static_assert(cxpr::unique_typehashes_v<cxpr::typeset<>>, "empty sets are trivially unique");
+
+#if defined(__GNUC__) && !defined(__clang__)
+	// gcc names both '<lambda(int)>', the check is what catches it
+	auto twice = [](int v) { return v * 2; };
+	auto negate = [](int v) { return -v; };
+	static_assert(cxpr::typehash_v<decltype(twice)> == cxpr::typehash_v<decltype(negate)>, "same-named lambdas share a hash");
+	static_assert(cxpr::unique_typehashes_v<cxpr::typeset<decltype(twice), decltype(negate)>> == false, "and collide");
+#endif
+}
@@ -0,0 +1,68 @@
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct login {};
+	struct logout {};
+	struct heartbeat {};
+}
+
+TEST(type_map_tests, static_lookup_test)
+{
+	using map_t = cxpr::type_map<cxpr::typeset<login, logout, heartbeat>, int>;
+	static_assert(map_t::size() == 3, "one slot per type");
+	static_assert(map_t::index_of<logout> == 1, "indices follow typeset order");
+	static_assert(map_t::index_of<const heartbeat&> == 2, "types are decayed");
+	static_assert(map_t::contains<login> && !map_t::contains<std::string>, "contains failed");
+
+	map_t counts;
+	counts.get<login>() += 2;
+	counts.get<heartbeat>()++;
+	EXPECT_EQ(counts.get<login>(), 2);
+	EXPECT_EQ(counts.get<logout>(), 0);
+	EXPECT_EQ(counts[2], 1);
+
+	int total = 0;
+	for (const auto& count : counts)
+	{
+		total += count;
+	}
+	EXPECT_EQ(total, 3);
+
+	constexpr cxpr::type_map<std::tuple<int, double>, std::string_view> names("int", "double");
+	static_assert(names.get<double>() == "double", "compile-time get failed");
+}
+
+TEST(type_map_tests, runtime_hash_test)
+{
+	using types_t = cxpr::typeset<int, float, double, char, std::string, login, logout, heartbeat,
+		unsigned, long, short, bool, std::string_view, uint64_t>;
+	cxpr::type_map<types_t, std::string_view> names;
+	names.get<int>() = "int";
+	names.get<std::string>() = "string";
+	names.get<heartbeat>() = "heartbeat";
+
+	ASSERT_NE(names.get(cxpr::typehash_v<heartbeat>), nullptr);
+	EXPECT_EQ(*names.get(cxpr::typehash_v<heartbeat>), "heartbeat");
+	EXPECT_EQ(*names.get(cxpr::typehash_v<const std::string&>), "string");
+	EXPECT_EQ(names.get(cxpr::typehash_v<long double>), nullptr);
+	EXPECT_EQ(names.get(0), nullptr);
+
+	// every type resolves to its own dense index
+	const cxpr::hash_t hashes[] = { cxpr::typehash_v<int>, cxpr::typehash_v<float>, cxpr::typehash_v<double>,
+		cxpr::typehash_v<char>, cxpr::typehash_v<std::string>, cxpr::typehash_v<login>, cxpr::typehash_v<logout>,
+		cxpr::typehash_v<heartbeat>, cxpr::typehash_v<unsigned>, cxpr::typehash_v<long>, cxpr::typehash_v<short>,
+		cxpr::typehash_v<bool>, cxpr::typehash_v<std::string_view>, cxpr::typehash_v<uint64_t> };
+	for (size_t i = 0; i < std::size(hashes); i++)
+	{
+		EXPECT_EQ(decltype(names)::find_index(hashes[i]), i);
+	}
+
+	static_assert(decltype(names)::find_index(cxpr::typehash_v<login>) == 5, "compile-time hash lookup failed");
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+TEST(utf_tests, validate_test)
+{
+	EXPECT_TRUE(cxpr::validate_utf(std::string_view("plain ascii")));
+	EXPECT_TRUE(cxpr::validate_utf(std::string_view("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80")));
+	EXPECT_EQ(cxpr::validate_utf(std::string_view("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80")).written, 8);
+
+	const auto check_bad = [](std::string_view in, size_t offset)
+	{
+		const auto res = cxpr::validate_utf(in);
+		EXPECT_EQ(res.status, cxpr::utf_status::invalid) << in;
+		EXPECT_EQ(res.read, offset) << in;
+	};
+	check_bad("ab\x80", 2);						// stray continuation
+	check_bad("ab\xC3", 2);						// truncated sequence
+	check_bad("\xC0\xAF", 0);					// overlong '/'
+	check_bad("x\xED\xA0\x80", 1);				// encoded surrogate
+	check_bad("\xF4\x90\x80\x80", 0);			// past U+10FFFF
+	check_bad("\xE2\x28\xA1", 0);				// bad continuation
+
+	// ASCII runs long enough for the vector scan, with the error after them
+	std::string longText(100, 'a');
+	longText += "\xFF";
+	check_bad(longText, 100);
+
+	EXPECT_TRUE(cxpr::validate_utf(std::u16string_view(u"\xD83D\xDE00")));
+	EXPECT_FALSE(cxpr::validate_utf(std::u16string_view(u"a\xDE00")));
+	EXPECT_FALSE(cxpr::validate_utf(std::u32string_view(U"\x110000")));
+}
+
+TEST(utf_tests, transcode_test)
+{
+	const std::string_view utf8 = "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80";
+	const std::u16string_view utf16 = u"caf\x00E9 \x20AC \xD83D\xDE00";
+	const std::u32string_view utf32 = U"caf\x00E9 \x20AC \x1F600";
+
+	{	// 8 -> 16 -> 32 -> 8
+		cxpr::basic_fixed_string<char16_t, 32> wide;
+		EXPECT_TRUE(cxpr::transcode(wide, utf8));
+		EXPECT_EQ(std::u16string_view(wide), utf16);
+
+		cxpr::basic_fixed_string<char32_t, 32> wider;
+		EXPECT_TRUE(cxpr::transcode(wider, wide));
+		EXPECT_EQ(std::u32string_view(wider), utf32);
+
+		cxpr::fixed_string<32> narrow;
+		const auto res = cxpr::transcode(narrow, wider);
+		EXPECT_TRUE(res);
+		EXPECT_EQ(res.read, utf32.size());
+		EXPECT_EQ(res.written, utf8.size());
+		EXPECT_EQ(narrow, utf8);
+	}
+
+	{	// longer than the staging buffer
+		std::string text;
+		for (int i = 0; i < 100; i++)
+		{
+			text += "ab\xC3\xA9";
+		}
+		cxpr::basic_fixed_string<char16_t, 512> wide;
+		ASSERT_TRUE(cxpr::transcode(wide, text));
+		EXPECT_EQ(wide.size(), 300);
+		cxpr::fixed_string<512> back;
+		ASSERT_TRUE(cxpr::transcode(back, wide));
+		EXPECT_EQ(back, text);
+	}
+
+	{	// malformed input writes nothing
+		cxpr::basic_fixed_string<char16_t, 32> wide(u"keep");
+		const auto res = cxpr::transcode_append(wide, std::string_view("ok\xC3("));
+		EXPECT_EQ(res.status, cxpr::utf_status::invalid);
+		EXPECT_EQ(res.read, 2);
+		EXPECT_EQ(std::u16string_view(wide), u"keep");
+	}
+
+	{	// truncation stops at a whole code point
+		cxpr::fixed_string<8> narrow;
+		const auto res = cxpr::transcode(narrow, utf16);
+		EXPECT_TRUE(res);
+		EXPECT_EQ(res.read, 5);
+		EXPECT_EQ(narrow, "caf\xC3\xA9 ");
+
+		cxpr::basic_fixed_string<char16_t, 8> pairs;
+		cxpr::transcode(pairs, std::u32string_view(U"abcdef\x1F600"));
+		EXPECT_EQ(std::u16string_view(pairs), u"abcdef");
+	}
+
+	{	// throwing strings are left alone
+		cxpr::fixed_string<8, cxpr::no_transform, cxpr::overrun_behavior_throw> narrow("x");
+		EXPECT_THROW(cxpr::transcode_append(narrow, utf32), std::runtime_error);
+		EXPECT_EQ(narrow, "x");
+	}
+
+	{	// compile-time
+		constexpr auto converted = []() constexpr
+		{
+			cxpr::basic_fixed_string<char16_t, 16> out;
+			cxpr::transcode(out, std::string_view("\xE2\x82\xAC" "5"));
+			return out;
+		}();
+		static_assert(converted.size() == 2 && converted.data()[0] == 0x20AC, "compile-time transcode failed");
+	}
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include <cxpr.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	struct circle { double r; };
+	struct square { double side; };
+	using shape_t = std::variant<circle, square>;
+
+	constexpr double area(const shape_t& s)
+	{
+		return cxpr::jump_visit([](const auto& v) -> double
+			{
+				if constexpr (std::is_same_v<std::decay_t<decltype(v)>, circle>)
+				{
+					return 3.0 * v.r * v.r;
+				}
+				else
+				{
+					return v.side * v.side;
+				}
+			}, s);
+	}
+}
+
+TEST(variant_tests, jump_visit_test)
+{
+	static_assert(area(shape_t{ circle{ 1.0 } }) == 3.0, "jump_visit works during compile");
+	static_assert(area(shape_t{ square{ 2.0 } }) == 4.0, "jump_visit works during compile");
+
+	// common return type: int and long -> long
+	std::variant<int, long, char> v = 'a';
+	auto widened = cxpr::jump_visit([](auto x) { return x + 0; }, v);
+	static_assert(std::is_same_v<decltype(widened), long>, "results decay to their common type");
+	EXPECT_EQ(widened, 'a');
+
+	// matching reference results are kept, which allows modifying through the visitor
+	std::variant<int, std::string> mutable_v = 5;
+	cxpr::jump_visit([](auto& x) { x += x; }, mutable_v);
+	EXPECT_EQ(std::get<int>(mutable_v), 10);
+
+	std::variant<int, double> numbers = 2.5;
+	double& ref = cxpr::jump_visit([&](auto&) -> double& { return std::get<double>(numbers); }, numbers);
+	EXPECT_EQ(&ref, &std::get<double>(numbers));
+
+	// rvalue variants hand out rvalues, so the value can be moved out
+	std::variant<std::unique_ptr<int>, int> owner = std::make_unique<int>(3);
+	auto moved = cxpr::jump_visit([](auto&& x) -> std::unique_ptr<int>
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(x)>, std::unique_ptr<int>>)
+			{
+				static_assert(std::is_rvalue_reference_v<decltype(x)>, "rvalue variant gives rvalue alternatives");
+				return std::move(x);
+			}
+			else
+			{
+				return std::make_unique<int>(x);
+			}
+		}, std::move(owner));
+	EXPECT_EQ(*moved, 3);
+	EXPECT_EQ(std::get<0>(owner), nullptr);
+}
+
+TEST(variant_tests, jump_visit_multiple_test)
+{
+	std::variant<int, double, char> a = 2.0;
+	std::variant<std::string, int> b = 7;
+	const std::variant<bool> c = true;
+
+	// every combination maps to its own cell: index is (a * 2 + b) * 1 + c
+	auto describe = [](const auto& x, const auto& y, const auto& z)
+	{
+		return std::string(typeid(x).name()) + typeid(y).name() + typeid(z).name();
+	};
+	EXPECT_EQ(cxpr::jump_visit(describe, a, b, c), std::string(typeid(double).name()) + typeid(int).name() + typeid(bool).name());
+
+	a = 'x';
+	b = std::string("s");
+	EXPECT_EQ(cxpr::jump_visit(describe, a, b, c), std::string(typeid(char).name()) + typeid(std::string).name() + typeid(bool).name());
+
+	auto sum = cxpr::jump_visit([](auto x, auto y) { return static_cast<double>(x) + static_cast<double>(y); },
+		std::variant<int, float>(1), std::variant<double, char>(char(2)));
+	EXPECT_EQ(sum, 3.0);
+}
+
+TEST(variant_tests, jump_visit_valueless_test)
+{
+	struct throws_on_copy
+	{
+		throws_on_copy() = default;
+		throws_on_copy(const throws_on_copy&) { throw std::runtime_error("copy"); }
+	};
+
+	std::variant<int, throws_on_copy> v = 1;
+	EXPECT_THROW(v.emplace<throws_on_copy>(throws_on_copy{}), std::runtime_error);
+	ASSERT_TRUE(v.valueless_by_exception());
+	EXPECT_THROW(cxpr::jump_visit([](const auto&) {}, v), std::bad_variant_access);
+}
+
+namespace
+{
+	template <typename ... funs_t>
+	struct overloaded : funs_t... { using funs_t::operator()...; };
+	template <typename ... funs_t>
+	overloaded(funs_t...) -> overloaded<funs_t...>;
+}
+
+TEST(variant_tests, batch_visit_test)
+{
+	using message_t = std::variant<int, std::string, double>;
+	std::vector<message_t> messages;
+	for (int i = 0; i < 200; i++)
+	{
+		switch (i % 3)
+		{
+		case 0: messages.emplace_back(i); break;
+		case 1: messages.emplace_back(std::to_string(i)); break;
+		default: messages.emplace_back(i + 0.5); break;
+		}
+	}
+
+	// whole_range: every alternative is one group in range order
+	std::vector<std::string> visited;
+	cxpr::batch_visit<cxpr::batch_order::whole_range>(messages, overloaded{
+		[&](const int& v) { visited.push_back("i" + std::to_string(v)); },
+		[&](const std::string& v) { visited.push_back("s" + v); },
+		[&](const double& v) { visited.push_back("d" + std::to_string(int(v))); } });
+
+	ASSERT_EQ(visited.size(), messages.size());
+	EXPECT_EQ(visited[0], "i0");
+	EXPECT_EQ(visited[1], "i3");
+	EXPECT_EQ(visited[66], "i198");
+	EXPECT_EQ(visited[67], "s1");
+	EXPECT_EQ(visited[133], "s199");
+	EXPECT_EQ(visited[134], "d2");
+	EXPECT_EQ(visited[199], "d197");
+
+	// blocked: same items, each alternative still in range order
+	std::vector<int> ints;
+	size_t others = 0;
+	cxpr::batch_visit(messages, overloaded{
+		[&](int& v) { ints.push_back(v); v = -v; },
+		[&](auto&) { others++; } });
+
+	ASSERT_EQ(ints.size(), 67);
+	EXPECT_EQ(others, 133);
+	EXPECT_TRUE(std::is_sorted(ints.begin(), ints.end()));
+	EXPECT_EQ(std::get<int>(messages[3]), -3); // non-const ranges can be modified
+
+	// a plain array and a reused scratch buffer
+	std::variant<char, int> small[] = { 'a', 1, 'b', 2 };
+	std::vector<size_t> scratch;
+	int sum = 0;
+	cxpr::batch_visit<cxpr::batch_order::whole_range>(small, [&](auto v) { sum = sum * 10 + (v & 0xF); }, scratch);
+	EXPECT_EQ(sum, 1212);
+	EXPECT_EQ(scratch.size(), 4);
+}